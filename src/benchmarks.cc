@@ -0,0 +1,619 @@
+#include "benchmarks.hpp"
+#include "tree.hpp"
+#include "redblacktree.hpp"
+#include "compactredblacktree.hpp"
+#include "bplustree.hpp"
+#include "persistentredblacktree.hpp"
+#include "concurrentredblacktree.hpp"
+#include "vanemdeboastree.hpp"
+#include "hashset.hpp"
+#include "skiplist.hpp"
+#include "mst.hpp"
+#include "timeutils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include <fmt/format.h>
+
+// Samples ranks [0, size) with probability proportional to 1/(rank+1)^skew.
+class ZipfDistribution
+{
+  private:
+    std::vector<double> cdf;
+
+  public:
+    ZipfDistribution(int32_t size, double skew)
+    :cdf(size)
+    {
+      double sum = 0.0;
+      for(int32_t i = 0; i < size; ++i)
+      {
+        sum += 1.0 / std::pow(i + 1, skew);
+        this->cdf[i] = sum;
+      }
+
+      for(auto &p : this->cdf)
+        p /= sum;
+    }
+
+    template<typename Generator>
+    int32_t operator()(Generator &generator)
+    {
+      std::uniform_real_distribution<double> distribution(0.0, 1.0);
+      auto rank = std::lower_bound(this->cdf.begin(), this->cdf.end(),
+                                   distribution(generator));
+      return std::min<int32_t>(rank - this->cdf.begin(), this->cdf.size() - 1);
+    }
+};
+
+// Returns keys [0, size) in random order.
+static std::vector<int32_t> shuffled_keys(int32_t size, std::mt19937 &generator)
+{
+  std::vector<int32_t> keys(size);
+  for(int32_t i = 0; i < size; ++i)
+    keys[i] = i;
+
+  std::shuffle(keys.begin(), keys.end(), generator);
+  return keys;
+}
+
+static void log_result(const char *f_name, const char *m_name,
+                       std::chrono::nanoseconds time)
+{
+  FILE *f_out = fopen(f_name, "a");
+  fmt::print(f_out, "{};{};\n", m_name, time.count());
+  fclose(f_out);
+}
+
+void sdizo::benchmarks::bench_tree_zipf
+(const char *f_name, int32_t size, int32_t queries, double skew) noexcept
+{
+  std::mt19937 generator(std::random_device{}());
+  auto keys = shuffled_keys(size, generator);
+
+  // Hot keys are spread over whole key range
+  ZipfDistribution zipf(size, skew);
+  std::vector<int32_t> lookups(queries);
+  for(auto &lookup : lookups)
+    lookup = keys[zipf(generator)];
+
+  sdizo::Tree dsw_tree;
+  sdizo::Tree splay_tree(sdizo::TreeBalance::splay);
+  sdizo::RedBlackTree rb_tree;
+
+  for(auto key : keys)
+  {
+    dsw_tree.insert(key);
+    splay_tree.insert(key);
+    rb_tree.insert(key);
+  }
+
+  dsw_tree.dsw();
+
+  auto dsw_time = sdizo::measure_nano([&]{
+    for(auto key : lookups)
+      dsw_tree.search(key);
+  });
+
+  auto splay_time = sdizo::measure_nano([&]{
+    for(auto key : lookups)
+      splay_tree.access(key);
+  });
+
+  auto rb_time = sdizo::measure_nano([&]{
+    for(auto key : lookups)
+      rb_tree.contains(key);
+  });
+
+  log_result(f_name, "Tree dsw zipf search", dsw_time);
+  log_result(f_name, "Tree splay zipf search", splay_time);
+  log_result(f_name, "RedBlackTree zipf search", rb_time);
+}
+
+template<typename RBTree>
+static void bench_rbt_operations(const char *f_name, const char *t_name,
+                                 const std::vector<int32_t> &keys,
+                                 const std::vector<int32_t> &lookups)
+{
+  RBTree tree;
+
+  auto insert_time = sdizo::measure_nano([&]{
+    for(auto key : keys)
+      tree.insert(key);
+  });
+
+  auto search_time = sdizo::measure_nano([&]{
+    for(auto key : lookups)
+      tree.contains(key);
+  });
+
+  auto remove_time = sdizo::measure_nano([&]{
+    for(auto key : lookups)
+      tree.remove(key);
+  });
+
+  log_result(f_name, fmt::format("{} insert", t_name).c_str(), insert_time);
+  log_result(f_name, fmt::format("{} search", t_name).c_str(), search_time);
+  log_result(f_name, fmt::format("{} remove", t_name).c_str(), remove_time);
+}
+
+void sdizo::benchmarks::bench_rbt_layout
+(const char *f_name, int32_t size) noexcept
+{
+  std::mt19937 generator(std::random_device{}());
+  auto keys = shuffled_keys(size, generator);
+  auto lookups = keys;
+  std::shuffle(lookups.begin(), lookups.end(), generator);
+
+  bench_rbt_operations<sdizo::RedBlackTree>
+    (f_name, "RedBlackTree", keys, lookups);
+  bench_rbt_operations<sdizo::CompactRedBlackTree>
+    (f_name, "CompactRedBlackTree", keys, lookups);
+  bench_rbt_operations<sdizo::BPlusTree>
+    (f_name, "BPlusTree", keys, lookups);
+  bench_rbt_operations<sdizo::PersistentRedBlackTree>
+    (f_name, "PersistentRedBlackTree", keys, lookups);
+}
+
+void sdizo::benchmarks::bench_rbt_sequential_insert
+(const char *f_name, int32_t size) noexcept
+{
+  std::mt19937 generator(std::random_device{}());
+  auto keys = shuffled_keys(size, generator);
+
+  sdizo::RedBlackTree ascending, descending, hinted, random;
+
+  auto ascending_time = sdizo::measure_nano([&]{
+    for(int32_t i = 0; i < size; ++i)
+      ascending.insert(i);
+  });
+
+  auto descending_time = sdizo::measure_nano([&]{
+    for(int32_t i = size - 1; i >= 0; --i)
+      descending.insert(i);
+  });
+
+  auto hinted_time = sdizo::measure_nano([&]{
+    for(int32_t i = size - 1; i >= 0; --i)
+      hinted.insert(hinted.begin(), i);
+  });
+
+  auto random_time = sdizo::measure_nano([&]{
+    for(auto key : keys)
+      random.insert(key);
+  });
+
+  log_result(f_name, "RedBlackTree ascending insert", ascending_time);
+  log_result(f_name, "RedBlackTree descending insert", descending_time);
+  log_result(f_name, "RedBlackTree descending hinted insert", hinted_time);
+  log_result(f_name, "RedBlackTree random insert", random_time);
+}
+
+// Fills a and b with size random keys, half of them shared.
+static void fill_set_operands(sdizo::RedBlackTree &a, sdizo::RedBlackTree &b,
+                              int32_t size, std::mt19937 &generator)
+{
+  auto keys = shuffled_keys(size * 2, generator);
+  std::vector<int32_t> a_keys(keys.begin(), keys.begin() + size);
+  std::vector<int32_t> b_keys(keys.begin() + size / 2,
+                              keys.begin() + size / 2 + size);
+
+  std::sort(a_keys.begin(), a_keys.end());
+  std::sort(b_keys.begin(), b_keys.end());
+
+  a.bulk_load(a_keys.data(), a_keys.data() + a_keys.size());
+  b.bulk_load(b_keys.data(), b_keys.data() + b_keys.size());
+}
+
+void sdizo::benchmarks::bench_rbt_set_operations
+(const char *f_name, int32_t size) noexcept
+{
+  using Operation = void (sdizo::RedBlackTree::*)(sdizo::RedBlackTree&, bool);
+  constexpr std::pair<const char*, Operation> operations[] = {
+    {"union", &sdizo::RedBlackTree::set_union},
+    {"intersection", &sdizo::RedBlackTree::set_intersection},
+    {"difference", &sdizo::RedBlackTree::set_difference},
+  };
+
+  std::mt19937 generator(std::random_device{}());
+
+  for(auto [o_name, operation] : operations)
+  {
+    for(bool parallel : {false, true})
+    {
+      sdizo::RedBlackTree a, b;
+      fill_set_operands(a, b, size, generator);
+
+      auto time = sdizo::measure_nano([&]{
+        (a.*operation)(b, parallel);
+      });
+
+      log_result(f_name, fmt::format("RedBlackTree {} {}", o_name,
+                 parallel ? "parallel" : "sequential").c_str(), time);
+    }
+  }
+}
+
+// Runs search(thread_id) in given count of threads, returns time
+// until all of them finish.
+template<typename Search>
+static std::chrono::nanoseconds measure_threads(int32_t threads,
+                                                Search &&search)
+{
+  return sdizo::measure_nano([&]{
+    std::vector<std::thread> workers;
+    for(int32_t i = 0; i < threads; ++i)
+      workers.emplace_back(search, i);
+
+    for(auto &worker : workers)
+      worker.join();
+  });
+}
+
+void sdizo::benchmarks::bench_rbt_concurrent_search
+(const char *f_name, int32_t size, int32_t queries) noexcept
+{
+  std::mt19937 generator(std::random_device{}());
+  auto keys = shuffled_keys(size, generator);
+
+  sdizo::ConcurrentRedBlackTree concurrent;
+  concurrent.insert(keys.data(), keys.data() + keys.size());
+
+  std::sort(keys.begin(), keys.end());
+  sdizo::RedBlackTree locked;
+  std::mutex lock;
+  locked.bulk_load(keys.data(), keys.data() + keys.size());
+
+  auto max_threads = std::max(8, int32_t(std::thread::hardware_concurrency()));
+  std::uniform_int_distribution<int32_t> distribution(0, size - 1);
+  std::vector<int32_t> lookups(queries * max_threads);
+  for(auto &lookup : lookups)
+    lookup = distribution(generator);
+
+  // Every thread does the same amount of work, so perfect
+  // scaling keeps time constant
+  for(int32_t threads = 1; threads <= max_threads; threads *= 2)
+  {
+    auto concurrent_time = measure_threads(threads, [&](int32_t id){
+      auto begin = lookups.begin() + id * queries;
+      for(auto it = begin; it != begin + queries; ++it)
+        concurrent.contains(*it);
+    });
+
+    auto locked_time = measure_threads(threads, [&](int32_t id){
+      auto begin = lookups.begin() + id * queries;
+      for(auto it = begin; it != begin + queries; ++it)
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        locked.contains(*it);
+      }
+    });
+
+    log_result(f_name, fmt::format("ConcurrentRedBlackTree search {} threads",
+               threads).c_str(), concurrent_time);
+    log_result(f_name, fmt::format("RedBlackTree mutex search {} threads",
+               threads).c_str(), locked_time);
+  }
+}
+
+void sdizo::benchmarks::bench_rbt_filter
+(const char *f_name, int32_t size, int32_t queries) noexcept
+{
+  std::mt19937 generator(std::random_device{}());
+
+  // Tree holds even keys, odd keys are misses
+  auto keys = shuffled_keys(size, generator);
+  for(auto &key : keys)
+    key *= 2;
+
+  sdizo::RedBlackTree plain, filtered;
+  for(auto key : keys)
+  {
+    plain.insert(key);
+    filtered.insert(key);
+  }
+  filtered.enable_filter(0.01);
+
+  std::uniform_int_distribution<int32_t> distribution(0, size - 1);
+  std::vector<int32_t> hits(queries), misses(queries);
+  for(int32_t i = 0; i < queries; ++i)
+  {
+    hits[i] = keys[distribution(generator)];
+    misses[i] = distribution(generator) * 2 + 1;
+  }
+
+  auto search = [](sdizo::RedBlackTree &rbt, const std::vector<int32_t> &keys){
+    return sdizo::measure_nano([&]{
+      for(auto key : keys)
+        rbt.contains(key);
+    });
+  };
+
+  auto filter = filtered.get_filter();
+  auto name = fmt::format("filter {:.4f} fpr, {} KiB",
+                          filter->false_positive_rate(),
+                          filter->memory_usage() / 1024);
+
+  log_result(f_name, "RedBlackTree miss search", search(plain, misses));
+  log_result(f_name, fmt::format("RedBlackTree miss search {}",
+             name).c_str(), search(filtered, misses));
+  log_result(f_name, "RedBlackTree hit search", search(plain, hits));
+  log_result(f_name, fmt::format("RedBlackTree hit search {}",
+             name).c_str(), search(filtered, hits));
+}
+
+template<typename Set, typename Successor>
+static void bench_ordered_set(const char *f_name, const char *t_name,
+                              const std::vector<int32_t> &keys,
+                              const std::vector<int32_t> &lookups,
+                              Successor &&successor)
+{
+  Set set;
+
+  auto insert_time = sdizo::measure_nano([&]{
+    for(auto key : keys)
+      set.insert(key);
+  });
+
+  auto search_time = sdizo::measure_nano([&]{
+    for(auto key : lookups)
+      set.contains(key);
+  });
+
+  // Summing results keeps compiler from dropping lookups without
+  // side effects
+  volatile int32_t checksum = 0;
+  auto successor_time = sdizo::measure_nano([&]{
+    int32_t sum = 0;
+    for(auto key : lookups)
+      sum += successor(set, key);
+    checksum = sum;
+  });
+
+  auto remove_time = sdizo::measure_nano([&]{
+    for(auto key : keys)
+      set.remove(key);
+  });
+
+  log_result(f_name, fmt::format("{} insert", t_name).c_str(), insert_time);
+  log_result(f_name, fmt::format("{} search", t_name).c_str(), search_time);
+  log_result(f_name, fmt::format("{} successor", t_name).c_str(),
+             successor_time);
+  log_result(f_name, fmt::format("{} remove", t_name).c_str(), remove_time);
+}
+
+void sdizo::benchmarks::bench_veb(const char *f_name, int32_t size) noexcept
+{
+  std::mt19937 generator(std::random_device{}());
+
+  const std::pair<const char*, std::pair<int32_t, int32_t>> ranges[] = {
+    {"dense", {0, size - 1}},
+    {"sparse", {std::numeric_limits<int32_t>::min(),
+                std::numeric_limits<int32_t>::max()}},
+  };
+
+  for(auto [range_name, range] : ranges)
+  {
+    // Same distribution as generate(), lookups both hit and miss
+    std::uniform_int_distribution<int32_t>
+      distribution(range.first, range.second);
+    std::vector<int32_t> keys(size), lookups(size);
+    for(auto &key : keys)
+      key = distribution(generator);
+    for(auto &lookup : lookups)
+      lookup = distribution(generator);
+
+    bench_ordered_set<sdizo::RedBlackTree>(f_name,
+      fmt::format("RedBlackTree {}", range_name).c_str(), keys, lookups,
+      [](const sdizo::RedBlackTree &tree, int32_t key){
+        auto next = tree.upper_bound(key);
+        return next == tree.end() ? 0 : *next;
+      });
+
+    bench_ordered_set<sdizo::VanEmdeBoasTree>(f_name,
+      fmt::format("VanEmdeBoasTree {}", range_name).c_str(), keys, lookups,
+      [](const sdizo::VanEmdeBoasTree &tree, int32_t key){
+        int32_t next;
+        return tree.successor(key, next) ? next : 0;
+      });
+  }
+}
+
+template<typename Set>
+static void bench_membership(const char *f_name, const char *t_name,
+                             const std::vector<int32_t> &keys,
+                             const std::vector<int32_t> &hits,
+                             const std::vector<int32_t> &misses)
+{
+  Set set;
+
+  auto insert_time = sdizo::measure_nano([&]{
+    for(auto key : keys)
+      set.insert(key);
+  });
+
+  auto hit_time = sdizo::measure_nano([&]{
+    for(auto key : hits)
+      set.contains(key);
+  });
+
+  auto miss_time = sdizo::measure_nano([&]{
+    for(auto key : misses)
+      set.contains(key);
+  });
+
+  auto remove_time = sdizo::measure_nano([&]{
+    for(auto key : hits)
+      set.remove(key);
+  });
+
+  log_result(f_name, fmt::format("{} insert", t_name).c_str(), insert_time);
+  log_result(f_name, fmt::format("{} hit search", t_name).c_str(), hit_time);
+  log_result(f_name, fmt::format("{} miss search", t_name).c_str(),
+             miss_time);
+  log_result(f_name, fmt::format("{} remove", t_name).c_str(), remove_time);
+}
+
+void sdizo::benchmarks::bench_hash_set
+(const char *f_name, int32_t size) noexcept
+{
+  std::mt19937 generator(std::random_device{}());
+
+  // Sets hold even keys, odd keys are misses
+  auto keys = shuffled_keys(size, generator);
+  for(auto &key : keys)
+    key *= 2;
+
+  auto hits = keys;
+  std::shuffle(hits.begin(), hits.end(), generator);
+
+  auto misses = hits;
+  for(auto &miss : misses)
+    miss += 1;
+
+  bench_membership<sdizo::HashSet>(f_name, "HashSet", keys, hits, misses);
+  bench_membership<sdizo::RedBlackTree>(f_name, "RedBlackTree",
+                                        keys, hits, misses);
+}
+
+void sdizo::benchmarks::bench_skiplist_concurrent
+(const char *f_name, int32_t size, int32_t operations) noexcept
+{
+  std::mt19937 generator(std::random_device{}());
+
+  // Half of keys of range are in sets at start
+  auto keys = shuffled_keys(size * 2, generator);
+  keys.resize(size);
+
+  sdizo::SkipList skiplist;
+  sdizo::RedBlackTree locked;
+  std::mutex lock;
+  for(auto key : keys)
+  {
+    skiplist.insert(key);
+    locked.insert(key);
+  }
+
+  auto max_threads = std::max(8, int32_t(std::thread::hardware_concurrency()));
+  std::uniform_int_distribution<int32_t> distribution(0, size * 2 - 1);
+  std::vector<int32_t> lookups(operations * max_threads);
+  for(auto &lookup : lookups)
+    lookup = distribution(generator);
+
+  // Operation kind is picked by key, so both sets get the same sequence
+  auto kind = [](int32_t key){return key % 10;};
+
+  for(int32_t threads = 1; threads <= max_threads; threads *= 2)
+  {
+    auto search_time = measure_threads(threads, [&](int32_t id){
+      auto begin = lookups.begin() + id * operations;
+      for(auto it = begin; it != begin + operations; ++it)
+        skiplist.contains(*it);
+    });
+
+    auto mixed_time = measure_threads(threads, [&](int32_t id){
+      auto begin = lookups.begin() + id * operations;
+      for(auto it = begin; it != begin + operations; ++it)
+      {
+        if(kind(*it) == 0)
+          skiplist.insert(*it);
+        else if(kind(*it) == 1)
+          skiplist.remove(*it);
+        else
+          skiplist.contains(*it);
+      }
+    });
+
+    auto locked_time = measure_threads(threads, [&](int32_t id){
+      auto begin = lookups.begin() + id * operations;
+      for(auto it = begin; it != begin + operations; ++it)
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        if(kind(*it) == 0)
+          locked.insert(*it);
+        else if(kind(*it) == 1)
+          locked.remove(*it);
+        else
+          locked.contains(*it);
+      }
+    });
+
+    log_result(f_name, fmt::format("SkipList search {} threads",
+               threads).c_str(), search_time);
+    log_result(f_name, fmt::format("SkipList mixed {} threads",
+               threads).c_str(), mixed_time);
+    log_result(f_name, fmt::format("RedBlackTree mutex mixed {} threads",
+               threads).c_str(), locked_time);
+  }
+}
+
+void sdizo::benchmarks::bench_disjoint_set
+(const char *f_name, int32_t size, int32_t edges) noexcept
+{
+  std::mt19937 generator(std::random_device{}());
+  std::uniform_int_distribution<int32_t> distribution(0, size - 1);
+
+  std::vector<std::pair<int32_t, int32_t>> pairs(edges);
+  for(auto &pair : pairs)
+    pair = {distribution(generator), distribution(generator)};
+
+  sdizo2::disjoint_set::DisjointSet ds(size);
+  sdizo2::disjoint_set::FlatDisjointSet flat(size);
+
+  auto ds_time = sdizo::measure_nano([&]{
+    for(auto [a, b] : pairs)
+      if(ds.findSet(a) != ds.findSet(b))
+        ds.unionSet(ds.get(a), ds.get(b));
+  });
+
+  auto flat_time = sdizo::measure_nano([&]{
+    for(auto [a, b] : pairs)
+      flat.unionSet(a, b);
+  });
+
+  log_result(f_name, "DisjointSet union", ds_time);
+  log_result(f_name, "FlatDisjointSet union", flat_time);
+}
+
+void sdizo::benchmarks::bench_disjoint_set_concurrent
+(const char *f_name, int32_t size, int32_t edges) noexcept
+{
+  std::mt19937 generator(std::random_device{}());
+  std::uniform_int_distribution<int32_t> distribution(0, size - 1);
+
+  std::vector<std::pair<int32_t, int32_t>> pairs(edges);
+  for(auto &pair : pairs)
+    pair = {distribution(generator), distribution(generator)};
+
+  sdizo2::disjoint_set::FlatDisjointSet flat(size);
+  auto flat_time = sdizo::measure_nano([&]{
+    for(auto [a, b] : pairs)
+      flat.unionSet(a, b);
+  });
+
+  log_result(f_name, "FlatDisjointSet components", flat_time);
+
+  sdizo2::disjoint_set::ConcurrentDisjointSet concurrent(size);
+  auto max_threads = std::max(8, int32_t(std::thread::hardware_concurrency()));
+
+  // Total work is fixed, so perfect scaling halves time
+  // with each doubling of threads
+  for(int32_t threads = 1; threads <= max_threads; threads *= 2)
+  {
+    concurrent.reset(size);
+
+    auto concurrent_time = measure_threads(threads, [&](int32_t id){
+      auto begin = pairs.begin() + int64_t(edges) * id / threads;
+      auto end = pairs.begin() + int64_t(edges) * (id + 1) / threads;
+      for(auto it = begin; it != end; ++it)
+        concurrent.unionSet(it->first, it->second);
+    });
+
+    log_result(f_name, fmt::format("ConcurrentDisjointSet components "
+               "{} threads", threads).c_str(), concurrent_time);
+  }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+
+namespace sdizo{
+  namespace benchmarks{
+    // Each benchmark appends results to file given by f_name
+    // in format "name;time in ns;".
+
+    // Searches keys from [0, size) drawn with Zipf distribution
+    // of given skew in Tree balanced with dsw, Tree in splay mode
+    // and RedBlackTree.
+    void bench_tree_zipf(const char *f_name, int32_t size,
+                         int32_t queries, double skew) noexcept;
+
+    // Inserts, searches and removes size random keys in RedBlackTree,
+    // CompactRedBlackTree, BPlusTree and PersistentRedBlackTree.
+    void bench_rbt_layout(const char *f_name, int32_t size) noexcept;
+
+    // Union, intersection and difference of two RedBlackTrees of
+    // size random keys, computed sequentially and in parallel.
+    void bench_rbt_set_operations(const char *f_name, int32_t size) noexcept;
+
+    // Inserts keys [0, size) into RedBlackTree in ascending order,
+    // descending order with and without hint, and random order.
+    void bench_rbt_sequential_insert(const char *f_name,
+                                     int32_t size) noexcept;
+
+    // Searches queries random keys from each of 1, 2, 4, ... threads in
+    // ConcurrentRedBlackTree and in RedBlackTree guarded by mutex,
+    // both holding keys [0, size).
+    void bench_rbt_concurrent_search(const char *f_name, int32_t size,
+                                     int32_t queries) noexcept;
+
+    // Searches queries absent and present keys in RedBlackTree of
+    // size random keys, with and without Bloom filter in front.
+    void bench_rbt_filter(const char *f_name, int32_t size,
+                          int32_t queries) noexcept;
+
+    // Inserts size keys drawn like generate() does, then searches,
+    // finds successors of and removes them in RedBlackTree and
+    // VanEmdeBoasTree. Keys come from dense range [0, size) and from
+    // whole int32_t range.
+    void bench_veb(const char *f_name, int32_t size) noexcept;
+
+    // Inserts size random keys, searches present and absent keys and
+    // removes them in HashSet and RedBlackTree.
+    void bench_hash_set(const char *f_name, int32_t size) noexcept;
+
+    // Runs operations searches, then operations mixed searches (80%),
+    // inserts (10%) and removes (10%) from each of 1, 2, 4, ... threads
+    // in SkipList and in RedBlackTree guarded by mutex, both starting
+    // with size random keys.
+    void bench_skiplist_concurrent(const char *f_name, int32_t size,
+                                   int32_t operations) noexcept;
+
+    // Joins ends of random edges over size elements in
+    // DisjointSet and FlatDisjointSet, skipping edges within one set
+    // like Kruskal does.
+    void bench_disjoint_set(const char *f_name, int32_t size,
+                            int32_t edges) noexcept;
+
+    // Finds connected components of random graph of size vertices
+    // and edges edges with FlatDisjointSet, then with
+    // ConcurrentDisjointSet on 1, 2, 4, ... threads sharing edges.
+    void bench_disjoint_set_concurrent(const char *f_name, int32_t size,
+                                       int32_t edges) noexcept;
+  }
+}
@@ -0,0 +1,75 @@
+#include "bloomfilter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <fmt/format.h>
+
+sdizo::BlockedBloomFilter::BlockedBloomFilter
+(size_t capacity, double false_positive_rate)
+:capacity{std::max<size_t>(capacity, 1)}, count{0}
+{
+  if(!(false_positive_rate > 0.0 && false_positive_rate < 1.0))
+    throw std::out_of_range(fmt::format(
+      "False positive rate {} is not in range (0, 1).", false_positive_rate));
+
+  // Optimal bits per element and count of hashes for classic filter
+  auto ln2 = std::log(2.0);
+  auto bits = -double(this->capacity) * std::log(false_positive_rate) /
+              (ln2 * ln2);
+
+  this->block_count = std::max<size_t>(1, std::ceil(bits / block_bits));
+  this->blocks = new Block[this->block_count];
+
+  auto bits_per_element = double(this->block_count * block_bits) /
+                          this->capacity;
+  this->hashes = std::clamp<int32_t>(std::lround(bits_per_element * ln2),
+                                     1, max_hashes);
+  this->clear();
+}
+
+sdizo::BlockedBloomFilter::~BlockedBloomFilter() noexcept
+{
+  delete [] this->blocks;
+}
+
+void sdizo::BlockedBloomFilter::insert(uint64_t hash) noexcept
+{
+  auto &block = this->blocks[this->block_index(hash)];
+
+  // Double hashing inside block, step is odd so bits do not repeat
+  uint32_t bit = uint32_t(hash);
+  uint32_t step = uint32_t(hash >> 16) | 1;
+  for(int32_t i = 0; i < this->hashes; ++i, bit += step)
+    block.words[(bit % block_bits) / 64] |= uint64_t{1} << (bit % 64);
+
+  ++this->count;
+}
+
+bool sdizo::BlockedBloomFilter::may_contain(uint64_t hash) const noexcept
+{
+  auto &block = this->blocks[this->block_index(hash)];
+
+  uint32_t bit = uint32_t(hash);
+  uint32_t step = uint32_t(hash >> 16) | 1;
+  for(int32_t i = 0; i < this->hashes; ++i, bit += step)
+    if(!(block.words[(bit % block_bits) / 64] & (uint64_t{1} << (bit % 64))))
+      return false;
+
+  return true;
+}
+
+void sdizo::BlockedBloomFilter::clear() noexcept
+{
+  for(size_t i = 0; i < this->block_count; ++i)
+    std::fill(std::begin(this->blocks[i].words),
+              std::end(this->blocks[i].words), 0);
+
+  this->count = 0;
+}
+
+double sdizo::BlockedBloomFilter::false_positive_rate() const noexcept
+{
+  auto bits = double(this->block_count * block_bits);
+  auto unset = std::exp(-double(this->hashes) * this->count / bits);
+  return std::pow(1.0 - unset, this->hashes);
+}
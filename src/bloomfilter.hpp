@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+namespace sdizo{
+  // Bloom filter where all bits of one element fall into single
+  // cache line sized block, so lookup touches one cache line.
+  // Works on hashes, see mix_hash() for turning keys into ones.
+  class BlockedBloomFilter
+  {
+    public:
+      static constexpr int32_t block_bits = 512;
+
+    private:
+      static constexpr int32_t max_hashes = 16;
+
+      struct alignas(64) Block
+      {
+        uint64_t words[block_bits / 64];
+      };
+
+      Block *blocks;
+      size_t block_count;
+      int32_t hashes;
+      // Count of elements filter was sized for.
+      size_t capacity;
+      size_t count;
+
+    public:
+      // Sizes filter so that with capacity elements inserted, about
+      // false_positive_rate of absent elements pass. Throws
+      // std::out_of_range if rate is not in (0, 1).
+      BlockedBloomFilter(size_t capacity, double false_positive_rate);
+      BlockedBloomFilter(const BlockedBloomFilter&) = delete;
+      ~BlockedBloomFilter() noexcept;
+
+      void insert(uint64_t hash) noexcept;
+      // False only if hash was never inserted.
+      bool may_contain(uint64_t hash) const noexcept;
+      void clear() noexcept;
+
+      // Expected fraction of absent elements passing the filter
+      // with current count of elements.
+      double false_positive_rate() const noexcept;
+
+      inline size_t memory_usage() const noexcept
+      {return this->block_count * sizeof(Block);}
+
+      inline size_t get_count() const noexcept
+      {return this->count;}
+
+      inline size_t get_capacity() const noexcept
+      {return this->capacity;}
+
+      inline int32_t get_hashes() const noexcept
+      {return this->hashes;}
+
+    private:
+      // High half of hash picks block, low half picks bits
+      inline size_t block_index(uint64_t hash) const noexcept
+      {return ((hash >> 32) * this->block_count) >> 32;}
+  };
+}
@@ -0,0 +1,562 @@
+#include "bplustree.hpp"
+#include <algorithm>
+#include <random>
+#include <fstream>
+#include <cstdio>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using sdizo::BPlusLeaf;
+using sdizo::BPlusInner;
+using sdizo::BPlusChild;
+
+static BPlusLeaf* new_leaf() noexcept
+{
+  auto leaf = new BPlusLeaf;
+  leaf->count = 0;
+  leaf->next = nullptr;
+  std::fill(leaf->keys, leaf->keys + sdizo::bplus_leaf_keys,
+            sdizo::BPlusTree::key_padding);
+  return leaf;
+}
+
+static BPlusInner* new_inner() noexcept
+{
+  auto inner = new BPlusInner;
+  inner->count = 0;
+  std::fill(inner->keys, inner->keys + sdizo::bplus_inner_keys,
+            sdizo::BPlusTree::key_padding);
+  return inner;
+}
+
+// Removes key at index and child right of it.
+static void erase(BPlusInner *inner, int32_t index) noexcept
+{
+  std::copy(inner->keys + index + 1, inner->keys + inner->count,
+            inner->keys + index);
+  std::copy(inner->children + index + 2, inner->children + inner->count + 1,
+            inner->children + index + 1);
+
+  --inner->count;
+  inner->keys[inner->count] = sdizo::BPlusTree::key_padding;
+}
+
+sdizo::BPlusTree::BPlusTree() noexcept
+:height{0}, size{0}
+{
+  this->root.leaf = new_leaf();
+}
+
+sdizo::BPlusTree::~BPlusTree() noexcept
+{
+  this->free(this->root, 0);
+}
+
+int32_t sdizo::BPlusTree::loadFromFile(const char *filename) noexcept
+{
+  std::ifstream file(filename);
+  int32_t num;
+  int32_t count;
+
+  file >> count;
+
+  while(file >> num && count)
+  {
+    this->insert(num);
+    --count;
+  }
+
+  return 0;
+}
+
+int32_t sdizo::BPlusTree::lower_bound
+(const int32_t *keys, int32_t count, int32_t element) noexcept
+{
+#ifdef __SSE2__
+  // Padding is never lower than element and node capacities are
+  // multiples of 4, so whole blocks can be compared
+  auto needle = _mm_set1_epi32(element);
+  int32_t lower = 0;
+
+  for(int32_t i = 0; i < count; i += 4)
+  {
+    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+    auto mask = _mm_cmplt_epi32(block, needle);
+    lower += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+  }
+
+  return lower;
+#else
+  return std::lower_bound(keys, keys + count, element) - keys;
+#endif
+}
+
+int32_t sdizo::BPlusTree::upper_bound
+(const int32_t *keys, int32_t count, int32_t element) noexcept
+{
+#ifdef __SSE2__
+  auto needle = _mm_set1_epi32(element);
+  int32_t greater = 0;
+  int32_t i = 0;
+
+  for(; i < count; i += 4)
+  {
+    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+    auto mask = _mm_cmpgt_epi32(block, needle);
+    greater += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+  }
+
+  // Padding is not greater only for element equal to key_padding
+  return std::min(i - greater, count);
+#else
+  return std::upper_bound(keys, keys + count, element) - keys;
+#endif
+}
+
+const BPlusLeaf* sdizo::BPlusTree::find_leaf(int32_t element) const noexcept
+{
+  auto node = this->root;
+  for(int32_t level = 0; level < this->height; ++level)
+  {
+    auto inner = node.inner;
+    node = inner->children[upper_bound(inner->keys, inner->count, element)];
+  }
+
+  return node.leaf;
+}
+
+bool sdizo::BPlusTree::contains(int32_t element) const noexcept
+{
+  auto leaf = this->find_leaf(element);
+  auto index = lower_bound(leaf->keys, leaf->count, element);
+  return index < leaf->count && leaf->keys[index] == element;
+}
+
+void sdizo::BPlusTree::insert(int32_t element) noexcept
+{
+  BPlusChild split;
+  int32_t separator;
+
+  if(!this->insert(this->root, 0, element, split, separator))
+    return;
+
+  // Root was split, tree grows by one level
+  auto new_root = new_inner();
+  new_root->count = 1;
+  new_root->keys[0] = separator;
+  new_root->children[0] = this->root;
+  new_root->children[1] = split;
+
+  this->root.inner = new_root;
+  ++this->height;
+}
+
+bool sdizo::BPlusTree::insert
+(BPlusChild node, int32_t level, int32_t element,
+ BPlusChild &split, int32_t &separator) noexcept
+{
+  if(level == this->height)
+  {
+    auto leaf = node.leaf;
+    auto index = lower_bound(leaf->keys, leaf->count, element);
+
+    if(index < leaf->count && leaf->keys[index] == element)
+      return false;
+
+    ++this->size;
+
+    if(leaf->count < bplus_leaf_keys)
+    {
+      std::copy_backward(leaf->keys + index, leaf->keys + leaf->count,
+                         leaf->keys + leaf->count + 1);
+      leaf->keys[index] = element;
+      ++leaf->count;
+      return false;
+    }
+
+    // Full leaf, upper half of keys goes to new right sibling
+    int32_t keys[bplus_leaf_keys + 1];
+    std::copy(leaf->keys, leaf->keys + index, keys);
+    keys[index] = element;
+    std::copy(leaf->keys + index, leaf->keys + bplus_leaf_keys,
+              keys + index + 1);
+
+    constexpr int32_t left_count = (bplus_leaf_keys + 2) / 2;
+    constexpr int32_t right_count = bplus_leaf_keys + 1 - left_count;
+
+    auto right = new_leaf();
+    std::copy(keys, keys + left_count, leaf->keys);
+    std::fill(leaf->keys + left_count, leaf->keys + bplus_leaf_keys,
+              key_padding);
+    std::copy(keys + left_count, keys + bplus_leaf_keys + 1, right->keys);
+
+    leaf->count = left_count;
+    right->count = right_count;
+    right->next = leaf->next;
+    leaf->next = right;
+
+    split.leaf = right;
+    separator = right->keys[0];
+    return true;
+  }
+
+  auto inner = node.inner;
+  auto index = upper_bound(inner->keys, inner->count, element);
+
+  BPlusChild child_split;
+  int32_t child_separator;
+
+  if(!this->insert(inner->children[index], level + 1, element,
+                   child_split, child_separator))
+    return false;
+
+  if(inner->count < bplus_inner_keys)
+  {
+    std::copy_backward(inner->keys + index, inner->keys + inner->count,
+                       inner->keys + inner->count + 1);
+    std::copy_backward(inner->children + index + 1,
+                       inner->children + inner->count + 1,
+                       inner->children + inner->count + 2);
+
+    inner->keys[index] = child_separator;
+    inner->children[index + 1] = child_split;
+    ++inner->count;
+    return false;
+  }
+
+  // Full inner node, middle key goes up to parent
+  int32_t keys[bplus_inner_keys + 1];
+  BPlusChild children[bplus_inner_keys + 2];
+
+  std::copy(inner->keys, inner->keys + index, keys);
+  keys[index] = child_separator;
+  std::copy(inner->keys + index, inner->keys + bplus_inner_keys,
+            keys + index + 1);
+
+  std::copy(inner->children, inner->children + index + 1, children);
+  children[index + 1] = child_split;
+  std::copy(inner->children + index + 1,
+            inner->children + bplus_inner_keys + 1, children + index + 2);
+
+  constexpr int32_t left_count = bplus_inner_keys / 2;
+  constexpr int32_t right_count = bplus_inner_keys - left_count;
+
+  auto right = new_inner();
+  std::copy(keys, keys + left_count, inner->keys);
+  std::fill(inner->keys + left_count, inner->keys + bplus_inner_keys,
+            key_padding);
+  std::copy(children, children + left_count + 1, inner->children);
+
+  std::copy(keys + left_count + 1, keys + bplus_inner_keys + 1, right->keys);
+  std::copy(children + left_count + 1, children + bplus_inner_keys + 2,
+            right->children);
+
+  inner->count = left_count;
+  right->count = right_count;
+
+  split.inner = right;
+  separator = keys[left_count];
+  return true;
+}
+
+void sdizo::BPlusTree::remove(int32_t element) noexcept
+{
+  if(!this->remove(this->root, 0, element))
+    return;
+
+  // Root left with single child, tree shrinks by one level
+  if(this->height > 0 && this->root.inner->count == 0)
+  {
+    auto old_root = this->root.inner;
+    this->root = old_root->children[0];
+    delete old_root;
+    --this->height;
+  }
+}
+
+bool sdizo::BPlusTree::remove
+(BPlusChild node, int32_t level, int32_t element) noexcept
+{
+  if(level == this->height)
+  {
+    auto leaf = node.leaf;
+    auto index = lower_bound(leaf->keys, leaf->count, element);
+
+    if(index >= leaf->count || leaf->keys[index] != element)
+      return false;
+
+    std::copy(leaf->keys + index + 1, leaf->keys + leaf->count,
+              leaf->keys + index);
+    --leaf->count;
+    leaf->keys[leaf->count] = key_padding;
+    --this->size;
+    return true;
+  }
+
+  auto inner = node.inner;
+  auto index = upper_bound(inner->keys, inner->count, element);
+
+  if(!this->remove(inner->children[index], level + 1, element))
+    return false;
+
+  // Separators equal to removed key are left as they are,
+  // they still divide key ranges of children correctly
+  if(level + 1 == this->height)
+  {
+    if(inner->children[index].leaf->count < leaf_min)
+      this->fix_leaf(inner, index);
+  }
+  else if(inner->children[index].inner->count < inner_min)
+    this->fix_inner(inner, index);
+
+  return true;
+}
+
+void sdizo::BPlusTree::fix_leaf(BPlusInner *parent, int32_t index) noexcept
+{
+  auto child = parent->children[index].leaf;
+
+  // Borrow last key of left sibling
+  if(index > 0)
+  {
+    auto left = parent->children[index - 1].leaf;
+    if(left->count > leaf_min)
+    {
+      std::copy_backward(child->keys, child->keys + child->count,
+                         child->keys + child->count + 1);
+      child->keys[0] = left->keys[left->count - 1];
+      ++child->count;
+
+      --left->count;
+      left->keys[left->count] = key_padding;
+
+      parent->keys[index - 1] = child->keys[0];
+      return;
+    }
+  }
+
+  // Borrow first key of right sibling
+  if(index < parent->count)
+  {
+    auto right = parent->children[index + 1].leaf;
+    if(right->count > leaf_min)
+    {
+      child->keys[child->count] = right->keys[0];
+      ++child->count;
+
+      std::copy(right->keys + 1, right->keys + right->count, right->keys);
+      --right->count;
+      right->keys[right->count] = key_padding;
+
+      parent->keys[index] = right->keys[0];
+      return;
+    }
+  }
+
+  // Both siblings at minimum, merge with one of them
+  auto left_index = index > 0 ? index - 1 : index;
+  auto left = parent->children[left_index].leaf;
+  auto right = parent->children[left_index + 1].leaf;
+
+  std::copy(right->keys, right->keys + right->count,
+            left->keys + left->count);
+  left->count += right->count;
+  left->next = right->next;
+
+  delete right;
+  erase(parent, left_index);
+}
+
+void sdizo::BPlusTree::fix_inner(BPlusInner *parent, int32_t index) noexcept
+{
+  auto child = parent->children[index].inner;
+
+  // Rotate through parent from left sibling
+  if(index > 0)
+  {
+    auto left = parent->children[index - 1].inner;
+    if(left->count > inner_min)
+    {
+      std::copy_backward(child->keys, child->keys + child->count,
+                         child->keys + child->count + 1);
+      std::copy_backward(child->children, child->children + child->count + 1,
+                         child->children + child->count + 2);
+
+      child->keys[0] = parent->keys[index - 1];
+      child->children[0] = left->children[left->count];
+      ++child->count;
+
+      parent->keys[index - 1] = left->keys[left->count - 1];
+      --left->count;
+      left->keys[left->count] = key_padding;
+      return;
+    }
+  }
+
+  // Rotate through parent from right sibling
+  if(index < parent->count)
+  {
+    auto right = parent->children[index + 1].inner;
+    if(right->count > inner_min)
+    {
+      child->keys[child->count] = parent->keys[index];
+      child->children[child->count + 1] = right->children[0];
+      ++child->count;
+
+      parent->keys[index] = right->keys[0];
+
+      std::copy(right->keys + 1, right->keys + right->count, right->keys);
+      std::copy(right->children + 1, right->children + right->count + 1,
+                right->children);
+      --right->count;
+      right->keys[right->count] = key_padding;
+      return;
+    }
+  }
+
+  // Both siblings at minimum, merge with separator from parent
+  auto left_index = index > 0 ? index - 1 : index;
+  auto left = parent->children[left_index].inner;
+  auto right = parent->children[left_index + 1].inner;
+
+  left->keys[left->count] = parent->keys[left_index];
+  std::copy(right->keys, right->keys + right->count,
+            left->keys + left->count + 1);
+  std::copy(right->children, right->children + right->count + 1,
+            left->children + left->count + 1);
+  left->count += right->count + 1;
+
+  delete right;
+  erase(parent, left_index);
+}
+
+void sdizo::BPlusTree::clear() noexcept
+{
+  this->free(this->root, 0);
+  this->root.leaf = new_leaf();
+  this->height = 0;
+  this->size = 0;
+}
+
+void sdizo::BPlusTree::free(BPlusChild node, int32_t level) noexcept
+{
+  if(level == this->height)
+  {
+    delete node.leaf;
+    return;
+  }
+
+  for(int32_t i = 0; i <= node.inner->count; ++i)
+    this->free(node.inner->children[i], level + 1);
+
+  delete node.inner;
+}
+
+void sdizo::BPlusTree::display() const noexcept
+{
+  puts("===========================");
+  this->display(this->root, 0, 0);
+  puts("===========================");
+}
+
+void sdizo::BPlusTree::display
+(BPlusChild node, int32_t level, int space) const noexcept
+{
+  constexpr int shift_width = 10;
+
+  if(level == this->height)
+  {
+    printf("%*s[", space, "");
+    for(int32_t i = 0; i < node.leaf->count; ++i)
+      printf(i ? " %i" : "%i", node.leaf->keys[i]);
+    puts("]");
+    return;
+  }
+
+  auto inner = node.inner;
+  for(int32_t i = inner->count; i >= 0; --i)
+  {
+    this->display(inner->children[i], level + 1, space + shift_width);
+    if(i > 0)
+      printf("%*s%i\n", space, "", inner->keys[i - 1]);
+  }
+}
+
+bool sdizo::BPlusTree::verify() const noexcept
+{
+  const BPlusLeaf *previous = nullptr;
+
+  if(!this->verify(this->root, 0, std::numeric_limits<int32_t>::min(),
+                   int64_t{key_padding} + 1, previous))
+    return false;
+
+  return previous->next == nullptr;
+}
+
+bool sdizo::BPlusTree::verify
+(BPlusChild node, int32_t level, int64_t low, int64_t high,
+ const BPlusLeaf *&previous) const noexcept
+{
+  bool is_leaf = level == this->height;
+  auto count = is_leaf ? node.leaf->count : node.inner->count;
+  auto keys = is_leaf ? node.leaf->keys : node.inner->keys;
+  auto capacity = is_leaf ? bplus_leaf_keys : bplus_inner_keys;
+  auto minimum = is_leaf ? leaf_min : inner_min;
+
+  // Root is allowed to be less filled
+  if(level > 0 && count < minimum)
+    return false;
+
+  if(!is_leaf && count < 1)
+    return false;
+
+  for(int32_t i = 0; i < count; ++i)
+  {
+    if(keys[i] < low || keys[i] >= high)
+      return false;
+
+    if(i > 0 && keys[i - 1] >= keys[i])
+      return false;
+  }
+
+  for(int32_t i = count; i < capacity; ++i)
+    if(keys[i] != key_padding)
+      return false;
+
+  if(is_leaf)
+  {
+    if(previous != nullptr && previous->next != node.leaf)
+      return false;
+
+    previous = node.leaf;
+    return true;
+  }
+
+  for(int32_t i = 0; i <= count; ++i)
+  {
+    int64_t child_low = i > 0 ? keys[i - 1] : low;
+    int64_t child_high = i < count ? keys[i] : high;
+
+    if(!this->verify(node.inner->children[i], level + 1,
+                     child_low, child_high, previous))
+      return false;
+  }
+
+  return true;
+}
+
+void sdizo::BPlusTree::generate
+(int32_t rand_range_begin, int32_t rand_range_end, int32_t size) noexcept
+{
+  std::random_device generator;
+  std::uniform_int_distribution<int32_t>
+   distribution(rand_range_begin, rand_range_end);
+
+  this->clear();
+  for(int32_t i = 0; i < size; ++i)
+  {
+    this->insert(distribution(generator));
+  }
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+namespace sdizo{
+  // Nodes are sized to whole cache lines. Key slots past count are kept
+  // at key_padding, so in-node search can compare all slots at once.
+  constexpr int32_t bplus_leaf_keys = 28;
+  constexpr int32_t bplus_inner_keys = 20;
+
+  struct alignas(64) BPlusLeaf
+  {
+    int32_t count;
+    int32_t keys[bplus_leaf_keys];
+    // Next leaf in key order, nullptr for last one.
+    BPlusLeaf *next;
+  };
+
+  struct BPlusInner;
+
+  // Child of inner node, leaf if inner node is on lowest level.
+  union BPlusChild
+  {
+    BPlusInner *inner;
+    BPlusLeaf *leaf;
+  };
+
+  struct alignas(64) BPlusInner
+  {
+    int32_t count;
+    // Child i holds keys in range [keys[i-1], keys[i]).
+    int32_t keys[bplus_inner_keys];
+    BPlusChild children[bplus_inner_keys + 1];
+  };
+
+  static_assert(sizeof(BPlusLeaf) == 128);
+  static_assert(sizeof(BPlusInner) == 256);
+
+  // Ordered set of int32_t kept in B+tree. Inserting element
+  // already in set does nothing.
+  class BPlusTree
+  {
+    public:
+      static constexpr int32_t key_padding =
+        std::numeric_limits<int32_t>::max();
+
+    private:
+      static constexpr int32_t leaf_min = bplus_leaf_keys / 2;
+      static constexpr int32_t inner_min = bplus_inner_keys / 2;
+
+      BPlusChild root;
+      // Count of inner levels, leaves are at depth height.
+      int32_t height;
+      int32_t size;
+
+    public:
+      BPlusTree() noexcept;
+      BPlusTree(const BPlusTree&) = delete;
+      ~BPlusTree() noexcept;
+
+      int32_t loadFromFile(const char *filename) noexcept;
+      void insert(int32_t element) noexcept;
+      void remove(int32_t element) noexcept;
+      void generate(int32_t rand_range_begin, int32_t rand_range_end,
+                    int32_t size) noexcept;
+
+      // Removes all elements
+      void clear() noexcept;
+      bool contains(int32_t element) const noexcept;
+
+      // Calls visit(element) for all elements in range [begin, end)
+      // in ascending order, walking linked leaves.
+      template<typename Visitor>
+      void scan(int32_t begin, int32_t end, Visitor &&visit) const;
+
+      void display() const noexcept;
+
+      // Checks order of keys, fill of nodes, separators and leaf links.
+      bool verify() const noexcept;
+
+      inline int32_t get_size() const noexcept
+      {return this->size;}
+
+      inline int32_t get_height() const noexcept
+      {return this->height;}
+
+    private:
+      // Count of keys lower than element.
+      static int32_t lower_bound(const int32_t *keys, int32_t count,
+                                 int32_t element) noexcept;
+      // Count of keys not greater than element.
+      static int32_t upper_bound(const int32_t *keys, int32_t count,
+                                 int32_t element) noexcept;
+
+      const BPlusLeaf* find_leaf(int32_t element) const noexcept;
+
+      // Insert into subtree, on split returns true and sets new right
+      // sibling and separator that goes up to parent.
+      bool insert(BPlusChild node, int32_t level, int32_t element,
+                  BPlusChild &split, int32_t &separator) noexcept;
+      // Removes from subtree, returns false if element not found.
+      bool remove(BPlusChild node, int32_t level, int32_t element) noexcept;
+      // Refills underflowed child at index of parent on given level.
+      void fix_leaf(BPlusInner *parent, int32_t index) noexcept;
+      void fix_inner(BPlusInner *parent, int32_t index) noexcept;
+
+      void free(BPlusChild node, int32_t level) noexcept;
+      void display(BPlusChild node, int32_t level, int space) const noexcept;
+      bool verify(BPlusChild node, int32_t level, int64_t low, int64_t high,
+                  const BPlusLeaf *&previous) const noexcept;
+  };
+}
+
+template<typename Visitor>
+void sdizo::BPlusTree::scan(int32_t begin, int32_t end, Visitor &&visit) const
+{
+  if(begin >= end)
+    return;
+
+  auto leaf = this->find_leaf(begin);
+  auto index = lower_bound(leaf->keys, leaf->count, begin);
+
+  for(; leaf != nullptr; leaf = leaf->next, index = 0)
+  {
+    for(; index < leaf->count; ++index)
+    {
+      if(leaf->keys[index] >= end)
+        return;
+
+      visit(leaf->keys[index]);
+    }
+  }
+}
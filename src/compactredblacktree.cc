@@ -0,0 +1,560 @@
+#include "compactredblacktree.hpp"
+#include <algorithm>
+#include <random>
+#include <fstream>
+
+using index_t = sdizo::CompactRedBlackTree::index_t;
+
+sdizo::CompactRedBlackTree::CompactRedBlackTree() noexcept
+:pool{new CompactRedBlackNode[initial_capacity]},
+ capacity{initial_capacity}, used{1}, free_list{null_index},
+ root{null_index}, size{0}
+{
+  // Guard node is black and points to itself
+  this->pool[null_index] = {0, null_index, null_index, 0};
+}
+
+sdizo::CompactRedBlackTree::CompactRedBlackTree
+(const CompactRedBlackTree& tree) noexcept
+:pool{new CompactRedBlackNode[tree.capacity]},
+ capacity{tree.capacity}, used{tree.used}, free_list{tree.free_list},
+ root{tree.root}, size{tree.size}
+{
+  // Free list is linked by indices too, so it is copied along
+  std::copy(tree.pool, tree.pool + tree.used, this->pool);
+}
+
+sdizo::CompactRedBlackTree::CompactRedBlackTree
+(CompactRedBlackTree&& tree) noexcept
+:pool{tree.pool}, capacity{tree.capacity}, used{tree.used},
+ free_list{tree.free_list}, root{tree.root}, size{tree.size}
+{
+  tree.pool = nullptr;
+  tree.capacity = 0;
+  tree.used = 0;
+  tree.free_list = null_index;
+  tree.root = null_index;
+  tree.size = 0;
+}
+
+sdizo::CompactRedBlackTree::~CompactRedBlackTree() noexcept
+{
+  delete [] this->pool;
+}
+
+sdizo::CompactRedBlackTree& sdizo::CompactRedBlackTree::operator=
+(const CompactRedBlackTree& tree) noexcept
+{
+  if(this != &tree)
+    *this = CompactRedBlackTree(tree);
+
+  return *this;
+}
+
+sdizo::CompactRedBlackTree& sdizo::CompactRedBlackTree::operator=
+(CompactRedBlackTree&& tree) noexcept
+{
+  // Old pool is freed by destructor of tree
+  std::swap(this->pool, tree.pool);
+  std::swap(this->capacity, tree.capacity);
+  std::swap(this->used, tree.used);
+  std::swap(this->free_list, tree.free_list);
+  std::swap(this->root, tree.root);
+  std::swap(this->size, tree.size);
+  return *this;
+}
+
+int32_t sdizo::CompactRedBlackTree::loadFromFile(const char *filename)
+noexcept
+{
+  std::ifstream file(filename);
+  int32_t num;
+  int32_t count;
+
+  file >> count;
+
+  while(file >> num && count)
+  {
+    this->insert(num);
+    --count;
+  }
+
+  return 0;
+}
+
+index_t sdizo::CompactRedBlackTree::alloc(int32_t element) noexcept
+{
+  index_t index;
+
+  if(this->free_list != null_index)
+  {
+    index = this->free_list;
+    this->free_list = this->node(index).left;
+  }
+  else
+  {
+    // Nodes are referenced by index, so pool can be simply moved
+    if(this->used == this->capacity)
+    {
+      auto new_pool = new CompactRedBlackNode[this->capacity * 2];
+      std::copy(this->pool, this->pool + this->capacity, new_pool);
+
+      delete [] this->pool;
+      this->pool = new_pool;
+      this->capacity *= 2;
+    }
+
+    index = this->used++;
+  }
+
+  this->node(index) = {element, null_index, null_index, red_bit};
+  return index;
+}
+
+void sdizo::CompactRedBlackTree::dealloc(index_t index) noexcept
+{
+  this->node(index).left = this->free_list;
+  this->free_list = index;
+}
+
+void sdizo::CompactRedBlackTree::insert(int32_t element) noexcept
+{
+  this->insert_node(this->alloc(element));
+  ++this->size;
+}
+
+void sdizo::CompactRedBlackTree::tree_insert(index_t index) noexcept
+{
+  index_t current_parent = null_index;
+  index_t current_node = this->root;
+  int32_t value = this->node(index).value;
+
+  while(current_node != null_index)
+  {
+    current_parent = current_node;
+
+    if(value < this->node(current_node).value)
+      current_node = this->node(current_node).left;
+    else
+      current_node = this->node(current_node).right;
+  }
+
+  this->set_parent(index, current_parent);
+  if(current_parent == null_index)
+    this->root = index;
+  else if(value < this->node(current_parent).value)
+    this->node(current_parent).left = index;
+  else
+    this->node(current_parent).right = index;
+}
+
+void sdizo::CompactRedBlackTree::insert_node(index_t index) noexcept
+{
+  this->tree_insert(index);
+
+  index_t uncle;
+  // redblacktree structure fix
+  while(index != this->root &&
+        this->color(this->parent(index)) == NodeColor::red)
+  {
+    index_t parent = this->parent(index);
+    index_t grand = this->parent(parent);
+    bool is_parent_left_child = parent == this->node(grand).left;
+
+    uncle = is_parent_left_child ? this->node(grand).right
+                                 : this->node(grand).left;
+
+    if(this->color(uncle) == NodeColor::red)
+    {
+      this->set_color(parent, NodeColor::black);
+      this->set_color(uncle, NodeColor::black);
+      this->set_color(grand, NodeColor::red);
+      index = grand;
+      continue;
+    }
+
+    if(is_parent_left_child)
+    {
+      if(index == this->node(parent).right)
+      {
+        index = parent;
+        rot_left(index);
+      }
+
+      parent = this->parent(index);
+      grand = this->parent(parent);
+      this->set_color(parent, NodeColor::black);
+      this->set_color(grand, NodeColor::red);
+      rot_right(grand);
+      break;
+    }
+    else
+    {
+      if(index == this->node(parent).left)
+      {
+        index = parent;
+        rot_right(index);
+      }
+
+      parent = this->parent(index);
+      grand = this->parent(parent);
+      this->set_color(parent, NodeColor::black);
+      this->set_color(grand, NodeColor::red);
+      rot_left(grand);
+      break;
+    }
+  }
+  this->set_color(this->root, NodeColor::black);
+}
+
+void sdizo::CompactRedBlackTree::remove(int32_t element)
+{
+  auto index = this->search(element);
+  if(index != null_index)
+  {
+    this->remove_node(index);
+    --this->size;
+  }
+}
+
+void sdizo::CompactRedBlackTree::remove_node(index_t index) noexcept
+{
+  index_t to_delete;
+  index_t to_delete_child;
+  index_t uncle;
+
+  if(this->node(index).left == null_index ||
+     this->node(index).right == null_index)
+    to_delete = index;
+  else
+    to_delete = this->successor(index);
+
+  if(this->node(to_delete).left != null_index)
+    to_delete_child = this->node(to_delete).left;
+  else
+    to_delete_child = this->node(to_delete).right;
+
+  // Guard node parent is set as well, fix up below depends on it
+  index_t to_delete_parent = this->parent(to_delete);
+  this->set_parent(to_delete_child, to_delete_parent);
+
+  if(to_delete_parent == null_index)
+    this->root = to_delete_child;
+  else if(to_delete == this->node(to_delete_parent).left)
+    this->node(to_delete_parent).left = to_delete_child;
+  else
+    this->node(to_delete_parent).right = to_delete_child;
+
+  if(to_delete != index)
+    this->node(index).value = this->node(to_delete).value;
+
+  // If removing black node, tree's black height needs to be fixed
+  if(this->color(to_delete) == NodeColor::black)
+  {
+    index_t x = to_delete_child;
+
+    while(x != this->root && this->color(x) == NodeColor::black)
+    {
+      index_t x_parent = this->parent(x);
+
+      if(x == this->node(x_parent).left)
+      {
+        uncle = this->node(x_parent).right;
+
+        if(this->color(uncle) == NodeColor::red)
+        {
+          this->set_color(uncle, NodeColor::black);
+          this->set_color(x_parent, NodeColor::red);
+          rot_left(x_parent);
+          uncle = this->node(x_parent).right;
+        }
+
+        if(this->color(this->node(uncle).left) == NodeColor::black &&
+           this->color(this->node(uncle).right) == NodeColor::black)
+        {
+          this->set_color(uncle, NodeColor::red);
+          x = x_parent;
+          continue;
+        }
+
+        if(this->color(this->node(uncle).right) == NodeColor::black)
+        {
+          this->set_color(this->node(uncle).left, NodeColor::black);
+          this->set_color(uncle, NodeColor::red);
+          rot_right(uncle);
+          uncle = this->node(x_parent).right;
+        }
+
+        this->set_color(uncle, this->color(x_parent));
+        this->set_color(x_parent, NodeColor::black);
+        this->set_color(this->node(uncle).right, NodeColor::black);
+        rot_left(x_parent);
+        x = this->root;
+      }
+      else
+      {
+        uncle = this->node(x_parent).left;
+
+        if(this->color(uncle) == NodeColor::red)
+        {
+          this->set_color(uncle, NodeColor::black);
+          this->set_color(x_parent, NodeColor::red);
+          rot_right(x_parent);
+          uncle = this->node(x_parent).left;
+        }
+
+        if(this->color(this->node(uncle).left) == NodeColor::black &&
+           this->color(this->node(uncle).right) == NodeColor::black)
+        {
+          this->set_color(uncle, NodeColor::red);
+          x = x_parent;
+          continue;
+        }
+
+        if(this->color(this->node(uncle).left) == NodeColor::black)
+        {
+          this->set_color(this->node(uncle).right, NodeColor::black);
+          this->set_color(uncle, NodeColor::red);
+          rot_left(uncle);
+          uncle = this->node(x_parent).left;
+        }
+
+        this->set_color(uncle, this->color(x_parent));
+        this->set_color(x_parent, NodeColor::black);
+        this->set_color(this->node(uncle).left, NodeColor::black);
+        rot_right(x_parent);
+        x = this->root;
+      }
+    }
+
+    this->set_color(x, NodeColor::black);
+  }
+
+  // Guard node must stay black and without parent
+  this->pool[null_index] = {0, null_index, null_index, 0};
+  this->dealloc(to_delete);
+}
+
+void sdizo::CompactRedBlackTree::clear() noexcept
+{
+  this->used = 1;
+  this->free_list = null_index;
+  this->root = null_index;
+  this->size = 0;
+}
+
+index_t sdizo::CompactRedBlackTree::search(int32_t element) const noexcept
+{
+  index_t current = this->root;
+  while(current != null_index && this->node(current).value != element)
+  {
+    if(this->node(current).value < element)
+      current = this->node(current).right;
+    else
+      current = this->node(current).left;
+  }
+
+  return current;
+}
+
+bool sdizo::CompactRedBlackTree::contains(int32_t element) const noexcept
+{
+  return this->search(element) != null_index;
+}
+
+index_t sdizo::CompactRedBlackTree::successor(index_t index) const noexcept
+{
+  if(this->node(index).right != null_index)
+    return this->min(this->node(index).right);
+
+  index_t current_parent = this->parent(index);
+
+  while(current_parent != null_index &&
+        index == this->node(current_parent).right)
+  {
+    index = current_parent;
+    current_parent = this->parent(index);
+  }
+
+  return current_parent;
+}
+
+index_t sdizo::CompactRedBlackTree::min(index_t index) const noexcept
+{
+  while(this->node(index).left != null_index)
+    index = this->node(index).left;
+  return index;
+}
+
+void sdizo::CompactRedBlackTree::rot_left(index_t index) noexcept
+{
+  index_t B = this->node(index).right;
+  index_t p = this->parent(index);
+
+  if(B != null_index)
+  {
+    this->node(index).right = this->node(B).left;
+    if(this->node(index).right != null_index)
+      this->set_parent(this->node(index).right, index);
+
+    this->node(B).left = index;
+    this->set_parent(B, p);
+    this->set_parent(index, B);
+
+    if(p != null_index)
+    {
+      if(this->node(p).left == index)
+        this->node(p).left = B;
+      else
+        this->node(p).right = B;
+    }
+    else this->root = B;
+  }
+}
+
+void sdizo::CompactRedBlackTree::rot_right(index_t index) noexcept
+{
+  index_t B = this->node(index).left;
+  index_t p = this->parent(index);
+
+  if(B != null_index)
+  {
+    this->node(index).left = this->node(B).right;
+    if(this->node(index).left != null_index)
+      this->set_parent(this->node(index).left, index);
+
+    this->node(B).right = index;
+    this->set_parent(B, p);
+    this->set_parent(index, B);
+
+    if(p != null_index)
+    {
+      if(this->node(p).left == index)
+        this->node(p).left = B;
+      else
+        this->node(p).right = B;
+    }
+    else this->root = B;
+  }
+}
+
+void sdizo::CompactRedBlackTree::display() const noexcept
+{
+  puts("===========================");
+  this->display(this->root, 0);
+  puts("===========================");
+}
+
+void sdizo::CompactRedBlackTree::display(index_t index, int space)
+const noexcept
+{
+  constexpr int shift_width = 10;
+
+  if(index == null_index)
+    return;
+
+  space += shift_width;
+
+  this->display(this->node(index).right, space);
+
+  if(this->color(index) == NodeColor::red)
+    printf("\u001b[31m");
+
+  printf("\n%*s%i\n", space - shift_width, " ", this->node(index).value);
+
+  if(this->color(index) == NodeColor::red)
+    printf("\u001b[0m");
+
+  this->display(this->node(index).left, space);
+}
+
+bool sdizo::CompactRedBlackTree::verify_values() const noexcept
+{
+  return this->verify_(this->root);
+}
+
+bool sdizo::CompactRedBlackTree::verify_(index_t index) const noexcept
+{
+  if(index == null_index)
+    return true;
+
+  const auto &node = this->node(index);
+
+  if(!(verify_(node.left) & verify_(node.right)))
+    return false;
+
+  if(node.right != null_index && node.value > this->node(node.right).value)
+    return false;
+
+  if(node.left != null_index && node.value <= this->node(node.left).value)
+    return false;
+
+  return true;
+}
+
+bool sdizo::CompactRedBlackTree::verify_connections() const noexcept
+{
+  return this->verify_connections(this->root) &&
+         this->parent(this->root) == null_index;
+}
+
+bool sdizo::CompactRedBlackTree::verify_connections(index_t index)
+const noexcept
+{
+  if(index == null_index)
+    return true;
+
+  const auto &node = this->node(index);
+
+  if(node.left != null_index && this->parent(node.left) != index)
+    return false;
+
+  if(node.right != null_index && this->parent(node.right) != index)
+    return false;
+
+  return this->verify_connections(node.left) &&
+         this->verify_connections(node.right);
+}
+
+bool sdizo::CompactRedBlackTree::verify_colors() const noexcept
+{
+  return this->color(this->root) == NodeColor::black &&
+         this->verify_colors(this->root) >= 0;
+}
+
+int32_t sdizo::CompactRedBlackTree::verify_colors(index_t index)
+const noexcept
+{
+  // Returns black height of subtree, or -1 if subtree is invalid
+  if(index == null_index)
+    return 0;
+
+  const auto &node = this->node(index);
+
+  if(this->color(index) == NodeColor::red &&
+     (this->color(node.left) == NodeColor::red ||
+      this->color(node.right) == NodeColor::red))
+    return -1;
+
+  auto left_height = this->verify_colors(node.left);
+  auto right_height = this->verify_colors(node.right);
+
+  if(left_height < 0 || left_height != right_height)
+    return -1;
+
+  return left_height + (this->color(index) == NodeColor::black);
+}
+
+void sdizo::CompactRedBlackTree::generate
+(int32_t rand_range_begin, int32_t rand_range_end, int32_t size) noexcept
+{
+  std::random_device generator;
+  std::uniform_int_distribution<int32_t>
+   distribution(rand_range_begin, rand_range_end);
+
+  this->clear();
+  for(int32_t i = 0; i < size; ++i)
+  {
+    this->insert(distribution(generator));
+  }
+}
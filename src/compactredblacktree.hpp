@@ -0,0 +1,126 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include "redblacktree.hpp"
+
+namespace sdizo{
+  // Red black tree node linked by 32 bit indices into node pool.
+  // Takes 16 bytes, against 32 bytes of RedBlackNode plus allocator
+  // overhead of allocating each node separately.
+  struct CompactRedBlackNode
+  {
+    int32_t value;
+    uint32_t left;
+    uint32_t right;
+    // Parent index shifted left by one, lowest bit holds color.
+    uint32_t parent_color;
+  };
+
+  static_assert(sizeof(CompactRedBlackNode) == 16);
+
+  // RedBlackTree with nodes kept in one growing pool and linked with
+  // indices instead of pointers, so whole tree can be relocated
+  // (or copied) as single block of memory.
+  class CompactRedBlackTree
+  {
+    public:
+      using index_t = uint32_t;
+
+      // Index of guard node, stands for missing child or parent.
+      static constexpr index_t null_index = 0;
+
+    private:
+      static constexpr uint32_t red_bit = 1;
+      static constexpr index_t initial_capacity = 16;
+
+      CompactRedBlackNode *pool;
+      index_t capacity;
+      // Count of pool slots ever handed out, including guard node.
+      index_t used;
+      // Removed nodes linked through left index.
+      index_t free_list;
+      index_t root;
+      int32_t size;
+
+    public:
+      CompactRedBlackTree() noexcept;
+      // Copies node pool as single block, indices stay valid.
+      CompactRedBlackTree(const CompactRedBlackTree& tree) noexcept;
+      // Moved from tree can only be destroyed or assigned to.
+      CompactRedBlackTree(CompactRedBlackTree&& tree) noexcept;
+      ~CompactRedBlackTree() noexcept;
+
+      CompactRedBlackTree& operator=(const CompactRedBlackTree& tree) noexcept;
+      CompactRedBlackTree& operator=(CompactRedBlackTree&& tree) noexcept;
+
+      int32_t loadFromFile(const char *filename) noexcept;
+      void insert(int32_t element) noexcept;
+      void remove(int32_t element);
+      void generate(int32_t rand_range_begin, int32_t rand_range_end,
+                    int32_t size) noexcept;
+
+      // Removes all elements, pool memory is kept for reuse.
+      void clear() noexcept;
+
+      // Returns null_index if element is not in tree.
+      index_t search(int32_t element) const noexcept;
+      bool contains(int32_t element) const noexcept;
+
+      void display() const noexcept;
+
+      bool verify_values() const noexcept;
+      bool verify_connections() const noexcept;
+      // Checks that no red node has red child and that all paths
+      // have the same count of black nodes.
+      bool verify_colors() const noexcept;
+
+      inline int32_t get_size() const noexcept
+      {return this->size;}
+
+      // Bytes taken by node pool.
+      inline size_t memory_usage() const noexcept
+      {return this->capacity * sizeof(CompactRedBlackNode);}
+
+    private:
+      inline CompactRedBlackNode& node(index_t index) const noexcept
+      {return this->pool[index];}
+
+      inline index_t parent(index_t index) const noexcept
+      {return this->pool[index].parent_color >> 1;}
+
+      inline void set_parent(index_t index, index_t parent) noexcept
+      {
+        auto &node = this->pool[index];
+        node.parent_color = (parent << 1) | (node.parent_color & red_bit);
+      }
+
+      inline NodeColor color(index_t index) const noexcept
+      {return this->pool[index].parent_color & red_bit ? NodeColor::red
+                                                       : NodeColor::black;}
+
+      inline void set_color(index_t index, NodeColor color) noexcept
+      {
+        auto &node = this->pool[index];
+        node.parent_color = (node.parent_color & ~red_bit) |
+                            (color == NodeColor::red ? red_bit : 0);
+      }
+
+      index_t alloc(int32_t element) noexcept;
+      void dealloc(index_t index) noexcept;
+
+      index_t successor(index_t index) const noexcept;
+      index_t min(index_t index) const noexcept;
+
+      void rot_left(index_t index) noexcept;
+      void rot_right(index_t index) noexcept;
+
+      void tree_insert(index_t index) noexcept;
+      void insert_node(index_t index) noexcept;
+      void remove_node(index_t index) noexcept;
+
+      void display(index_t index, int space) const noexcept;
+      bool verify_(index_t index) const noexcept;
+      bool verify_connections(index_t index) const noexcept;
+      int32_t verify_colors(index_t index) const noexcept;
+  };
+}
@@ -0,0 +1,129 @@
+#include "concurrentredblacktree.hpp"
+#include <random>
+#include <fstream>
+#include <vector>
+
+sdizo::ConcurrentRedBlackTree::ConcurrentRedBlackTree()
+:published{new PersistentRedBlackTree}, root{nullptr}, size{0}
+{}
+
+sdizo::ConcurrentRedBlackTree::~ConcurrentRedBlackTree() noexcept
+{
+  delete this->published;
+}
+
+int32_t sdizo::ConcurrentRedBlackTree::loadFromFile(const char *filename)
+{
+  std::ifstream file(filename);
+  std::vector<int32_t> elements;
+  int32_t num;
+  int32_t count;
+
+  file >> count;
+
+  while(file >> num && count)
+  {
+    elements.push_back(num);
+    --count;
+  }
+
+  this->insert(elements.data(), elements.data() + elements.size());
+  return 0;
+}
+
+void sdizo::ConcurrentRedBlackTree::publish()
+{
+  auto version = new PersistentRedBlackTree(this->tree);
+
+  this->root.store(version->get_root());
+  this->size.store(version->get_size(), std::memory_order_relaxed);
+
+  this->epochs.retire(this->published);
+  this->published = version;
+}
+
+void sdizo::ConcurrentRedBlackTree::insert(int32_t element)
+{
+  std::lock_guard<std::mutex> lock(this->writer);
+  this->tree.insert(element);
+  this->publish();
+}
+
+void sdizo::ConcurrentRedBlackTree::insert
+(const int32_t *begin, const int32_t *end)
+{
+  std::lock_guard<std::mutex> lock(this->writer);
+
+  // Only first copy of each path node is shared with readers,
+  // rest of batch modifies copies in place
+  for(; begin != end; ++begin)
+    this->tree.insert(*begin);
+
+  this->publish();
+}
+
+void sdizo::ConcurrentRedBlackTree::remove(int32_t element)
+{
+  std::lock_guard<std::mutex> lock(this->writer);
+
+  if(!this->tree.contains(element))
+    return;
+
+  this->tree.remove(element);
+  this->publish();
+}
+
+void sdizo::ConcurrentRedBlackTree::generate
+(int32_t rand_range_begin, int32_t rand_range_end, int32_t size)
+{
+  std::random_device generator;
+  std::uniform_int_distribution<int32_t>
+   distribution(rand_range_begin, rand_range_end);
+
+  std::vector<int32_t> elements(size);
+  for(auto &element : elements)
+    element = distribution(generator);
+
+  std::lock_guard<std::mutex> lock(this->writer);
+  this->tree.clear();
+  for(auto element : elements)
+    this->tree.insert(element);
+
+  this->publish();
+}
+
+void sdizo::ConcurrentRedBlackTree::clear()
+{
+  std::lock_guard<std::mutex> lock(this->writer);
+  this->tree.clear();
+  this->publish();
+}
+
+bool sdizo::ConcurrentRedBlackTree::contains(int32_t element) const
+{
+  auto guard = this->epochs.pin();
+
+  auto node = this->root.load();
+  while(node != nullptr && node->value != element)
+  {
+    if(element < node->value)
+      node = node->left;
+    else
+      node = node->right;
+  }
+
+  return node != nullptr;
+}
+
+void sdizo::ConcurrentRedBlackTree::display()
+{
+  std::lock_guard<std::mutex> lock(this->writer);
+  this->tree.display();
+}
+
+bool sdizo::ConcurrentRedBlackTree::verify()
+{
+  std::lock_guard<std::mutex> lock(this->writer);
+  return this->tree.verify() &&
+         this->root.load() == this->tree.get_root();
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include "persistentredblacktree.hpp"
+#include "epoch.hpp"
+
+namespace sdizo{
+  // Red black tree safe for many readers and writers. Writers are
+  // serialized by mutex and modify private PersistentRedBlackTree, then
+  // publish its snapshot with single atomic store. Readers walk published
+  // snapshot without locks, replaced snapshots are released only after
+  // readers that could see them are done (see EpochManager).
+  class ConcurrentRedBlackTree
+  {
+    private:
+      using node_t = PersistentRedBlackTree::node_t;
+
+      // Version modified by writer.
+      PersistentRedBlackTree tree;
+      // Version seen by readers. Holding it keeps its nodes shared,
+      // so writer copies them instead of modifying in place.
+      PersistentRedBlackTree *published;
+      std::atomic<const node_t*> root;
+      std::atomic<int32_t> size;
+      std::mutex writer;
+      mutable EpochManager epochs;
+
+    public:
+      ConcurrentRedBlackTree();
+      ConcurrentRedBlackTree(const ConcurrentRedBlackTree&) = delete;
+      ~ConcurrentRedBlackTree() noexcept;
+
+      int32_t loadFromFile(const char *filename);
+      void insert(int32_t element);
+      // Inserts all elements of range, readers see either
+      // none or all of them.
+      void insert(const int32_t *begin, const int32_t *end);
+      void remove(int32_t element);
+      void generate(int32_t rand_range_begin, int32_t rand_range_end,
+                    int32_t size);
+
+      // Removes all elements
+      void clear();
+
+      // Lock free.
+      bool contains(int32_t element) const;
+
+      void display();
+      bool verify();
+
+      inline int32_t get_size() const noexcept
+      {return this->size.load(std::memory_order_relaxed);}
+
+    private:
+      // Makes current version of tree visible to readers,
+      // writer lock must be held.
+      void publish();
+  };
+}
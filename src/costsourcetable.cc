@@ -1,7 +1,8 @@
 #include "costsourcetable.hpp"
 
 sdizo2::CostSourceTable::CostSourceTable(int32_t size) noexcept
-:cost_table(new int32_t[size]), source_table(new int32_t[size]), size(size)
+:cost_table(new int32_t[size]), source_table(new int32_t[size]),
+ version_table(new uint32_t[size]()), version(0), size(size)
 {
   this->reset();
 }
@@ -11,10 +12,14 @@ sdizo2::CostSourceTable::CostSourceTable
 {
   this->cost_table = cst.cost_table;
   this->source_table = cst.source_table;
+  this->version_table = cst.version_table;
+  this->version = cst.version;
   this->size = cst.size;
 
   cst.cost_table = nullptr;
   cst.source_table = nullptr;
+  cst.version_table = nullptr;
+  cst.version = 0;
   cst.size = 0;
 }
 
@@ -22,32 +27,34 @@ sdizo2::CostSourceTable::~CostSourceTable() noexcept
 {
   delete [] this->cost_table;
   delete [] this->source_table;
+  delete [] this->version_table;
 }
 
 void sdizo2::CostSourceTable::reset() noexcept
 {
-  if(this->size <= 0)
-    return;
+  ++this->version;
 
-  std::fill(this->cost_table, this->cost_table+this->size,
-            sdizo2::CostSourceTable::INF);
-  std::fill(this->source_table, this->source_table+this->size,
-            sdizo2::CostSourceTable::INVALID_SOURCE);
+  // On wrap around old versions could become valid again
+  if(this->version == 0)
+  {
+    std::fill(this->version_table, this->version_table+this->size, 0);
+    this->version = 1;
+  }
 }
 
 void sdizo2::CostSourceTable::set_if_smaller (sdizo2::Edge edge)
 {
-  if(this->cost_table[edge.v2] <= edge.weight)
+  if(this->get_cost(edge.v2) <= edge.weight)
     return;
 
-  this->cost_table[edge.v2] = edge.weight;
-  this->source_table[edge.v2] = edge.v1;
+  this->set(edge);
 }
 
 void sdizo2::CostSourceTable::set(sdizo2::Edge edge)
 {
   this->cost_table[edge.v2] = edge.weight;
   this->source_table[edge.v2] = edge.v1;
+  this->version_table[edge.v2] = this->version;
 }
 
 int32_t sdizo2::CostSourceTable::get_cost(int32_t index)
@@ -55,6 +62,9 @@ int32_t sdizo2::CostSourceTable::get_cost(int32_t index)
   if(index >= this->size || index < 0)
     throw std::out_of_range("Tried getting cost if node that is out of rrange.");
 
+  if(!this->is_valid(index))
+    return sdizo2::CostSourceTable::INF;
+
   return this->cost_table[index];
 }
 
@@ -63,6 +73,9 @@ int32_t sdizo2::CostSourceTable::get_source(int32_t index)
   if(index >= this->size || index < 0)
     throw std::out_of_range("Tried getting cost if node that is out of rrange.");
 
+  if(!this->is_valid(index))
+    return sdizo2::CostSourceTable::INVALID_SOURCE;
+
   return this->source_table[index];
 }
 
@@ -70,11 +83,15 @@ void sdizo2::CostSourceTable::resize(int32_t newsize) noexcept
 {
   delete [] this->cost_table;
   delete [] this->source_table;
+  delete [] this->version_table;
 
   this->cost_table = new int32_t[newsize];
   this->source_table = new int32_t[newsize];
+  this->version_table = new uint32_t[newsize]();
 
   this->size = newsize;
+  this->version = 0;
+  this->reset();
 }
 
 void sdizo2::CostSourceTable::display()
@@ -90,29 +107,29 @@ noexcept
 
   fmt::print("{:>{}} ", "Cost ->", alignment);
   for(auto i = 0; i < this->size; ++i)
-    if(this->cost_table[i] == INF)
+    if(this->get_cost(i) == INF)
       fmt::print("{:<10} ", "INF");
     else
-      fmt::print("{:<10} ", this->cost_table[i]);
+      fmt::print("{:<10} ", this->get_cost(i));
 
   putchar('\n');
 
   fmt::print("{:>{}} ", "Destination ->", alignment);
   for(auto i = 0; i < this->size; ++i)
-    fmt::print("{:<10} ", this->source_table[i]);
+    fmt::print("{:<10} ", this->get_source(i));
 
   putchar('\n');
 
   // Print path for each node from starting node
   for(auto i = 0; i < this->size; ++i)
   {
-    auto current_node = this->source_table[i];
+    auto current_node = this->get_source(i);
     fmt::print("{}", i);
 
     while(current_node != -1)
     {
       fmt::print(" <- {}", current_node);
-      current_node = this->source_table[current_node];
+      current_node = this->get_source(current_node);
     }
 
     putchar('\n');
@@ -12,6 +12,8 @@ namespace sdizo2
 // Table shows for example that to node 4 we can come from node 0
 // with total summary cost of 3.
 // It initializes table with infinity values for costs and -1 for source.
+// Entries are versioned, so reset between queries does not touch
+// whole table, only entries set since last reset are valid.
 class CostSourceTable
 {
 public:
@@ -21,6 +23,8 @@ public:
 private:
   int32_t *cost_table;
   int32_t *source_table;
+  uint32_t *version_table;
+  uint32_t version;
   int32_t size;
 
 public:
@@ -28,6 +32,7 @@ public:
   CostSourceTable(CostSourceTable&& cst) noexcept;
   ~CostSourceTable() noexcept;
 
+  // Invalidates all entries in O(1).
   void reset() noexcept;
   void set_if_smaller(sdizo2::Edge edge);
   void set(sdizo2::Edge edge);
@@ -35,9 +40,14 @@ public:
   int32_t get_cost(int32_t index);
   int32_t get_source(int32_t index);
 
+  // Reallocs and resets table.
   void resize(int32_t newsize) noexcept;
 
   void display() noexcept;
+
+private:
+  inline bool is_valid(int32_t index) const noexcept
+  {return this->version_table[index] == this->version;}
 };
 }; // namespace sdizo2
 
@@ -4,7 +4,7 @@
 #include "fmt_custom.hpp"
 
 sdizo2::dijkstra::DijkstraSolver::DijkstraSolver(int32_t size) noexcept
-:cst(size),
+:cst(size), node_heap(size),
  edge_list(new sdizo::List<sdizo::ListNode<MSTListNode>>[size]),
  node_matrix(size), size(size), starting_node(0) {}
 
@@ -140,6 +140,7 @@ noexcept
 void sdizo2::dijkstra::DijkstraSolver::resize(int32_t newsize) noexcept
 {
   this->cst.resize(newsize);
+  this->node_heap.resize(newsize);
 
   delete [] this->edge_list;
   this->edge_list =
@@ -153,16 +154,24 @@ void sdizo2::dijkstra::DijkstraSolver::resize(int32_t newsize) noexcept
 }
 
 void sdizo2::dijkstra::DijkstraSolver::solve() noexcept
+{
+  this->solve_from(this->starting_node);
+  this->display();
+}
+
+void sdizo2::dijkstra::DijkstraSolver::solve_from(int32_t source)
 {
   constexpr auto INF = sdizo2::CostSourceTable::INF;
 
-  sdizo2::dijkstra::LookupHeap node_heap(this->size);
-  this->cst.reset(); // TODO do i need this?
-  this->set_starting_node(this->starting_node);
+  // Checked before workspace of previous query is touched
+  if(source < 0 || source >= this->size)
+    throw std::out_of_range(fmt::format("Source node out of range, "
+      "expected in range [0,{}), got {}", this->size, source));
 
-  node_heap.reset();
+  this->cst.reset();
+  this->set_starting_node(source);
 
-  this->display();
+  node_heap.reset(source);
 
   while(!node_heap.is_empty())
   {
@@ -199,11 +208,10 @@ void sdizo2::dijkstra::DijkstraSolver::solve_matrix() noexcept
 {
   constexpr auto INF = sdizo2::CostSourceTable::INF;
 
-  sdizo2::dijkstra::LookupHeap node_heap(this->size);
-  this->cst.reset(); // TODO do i need this?
+  this->cst.reset();
   this->set_starting_node(this->starting_node);
 
-  node_heap.reset();
+  node_heap.reset(this->starting_node);
 
   while(!node_heap.is_empty())
   {
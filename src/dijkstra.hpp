@@ -1,9 +1,11 @@
 #pragma once
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 #include "list.hpp"
 #include "heap.hpp"
+#include "heapstats.hpp"
 #include "mst.hpp"
 #include "costsourcetable.hpp"
 
@@ -47,38 +49,6 @@ struct DijkstraNode
   }
 };
 
-class DijkstraSolver
-{
-private:
-  sdizo2::CostSourceTable cst;
-  sdizo::List<sdizo::ListNode<MSTListNode>> *edge_list;
-  sdizo2::MSTMatrix node_matrix;
-
-  int32_t size;
-  int32_t starting_node;
-
-public:
-  DijkstraSolver(int32_t size) noexcept;
-  DijkstraSolver(DijkstraSolver&& solver) noexcept = default;
-  ~DijkstraSolver() noexcept;
-
-  void loadFromFile(const char *filename);
-  static DijkstraSolver buildFromFile(const char *filename);
-
-  int32_t generate(int32_t node_cnt, double density) noexcept;
-  void resize(int32_t newsize) noexcept;
-
-  void solve() noexcept;
-  void solve_matrix() noexcept;
-
-  void display() noexcept;
-  void display_list() noexcept;
-  void display_matrix() noexcept;
-
-private:
-  void set_starting_node(int32_t snode) noexcept;
-};
-
 #ifndef HEAP_MACROS
 #define HEAP_MACROS
 #define PARENT(i) ((i - 1)>>1)
@@ -86,22 +56,48 @@ private:
 #define RIGHT(i) ((i+1)<<1)
 #endif
 
+// Layout of heap entries.
+// packed - cost in high and node in low bits of single 64 bit integer,
+//          entries are compared with single integer compare.
+// soa    - costs and nodes in separate arrays, costs are contiguous.
+enum class HeapLayout
+{packed, soa};
+
+template<HeapLayout layout = HeapLayout::packed>
 class LookupHeap
 {
   public:
     using ElemType = sdizo2::dijkstra::DijkstraNode;
 
   private:
+    using entry_t = std::conditional_t<layout == HeapLayout::packed,
+                                       uint64_t, int32_t>;
+
     // Each time heap expands in memory (need to be relocated)
     // it allocates memory of size given in expand_size * sizeof(remove_ptr(array_type)).
     constexpr static size_t expand_size = 4;
 
+    // Flipping sign bit keeps order of signed costs in unsigned key.
+    constexpr static uint32_t sign_bit = 0x80000000u;
+
   private:
-    ElemType *array;
+    // Keys of heap, order of entries is order of keys.
+    entry_t *array;
+    // Nodes of entries, used only in soa layout.
+    int32_t *node_array;
     int32_t *lookup_table;
+    // Entry in lookup_table is valid only if node's stamp equals current
+    // epoch, so reset and clear do not need to refill the whole lookup
+    // table. Epoch starts at 1.
+    uint32_t *epoch_table;
+    uint32_t epoch;
     int32_t ssize;
     int32_t length;
 
+#ifdef SDIZO_HEAP_STATS
+    mutable sdizo::HeapStats stats;
+#endif
+
   public:
     LookupHeap(int32_t size) noexcept;
     LookupHeap(LookupHeap&& h) noexcept;
@@ -112,7 +108,7 @@ class LookupHeap
     ElemType at(int32_t index) const;
 
     inline ElemType pop()
-    {ElemType ret = this->at(0); this->removeAt(0); return ret;}
+    {HEAP_STAT(pops); ElemType ret = this->at(0); this->removeAt(0); return ret;}
 
     // Removes all elements
     void clear() noexcept;
@@ -122,8 +118,14 @@ class LookupHeap
     // Checks if container is proper heap
     bool verify() const noexcept;
 
+    // Empties heap and inserts only starting node, other nodes
+    // are inserted lazily on first update.
     void reset(int32_t starting_node = 0);
 
+    // Reallocs heap for given node count.
+    void resize(int32_t newsize) noexcept;
+
+    // Decreases cost of node, inserts node if it was not discovered yet.
     void update(int32_t node, int32_t cost);
 
     inline decltype(auto) get_ssize() const noexcept
@@ -132,17 +134,81 @@ class LookupHeap
     inline bool is_empty() const noexcept
     {return this->ssize == 0;}
 
+    // Returns operation counters, all zero if SDIZO_HEAP_STATS is not defined.
+    inline sdizo::HeapStats get_stats() const noexcept
+    {
+#ifdef SDIZO_HEAP_STATS
+      return this->stats;
+#else
+      return {};
+#endif
+    }
+
+    inline void reset_stats() noexcept
+    {
+#ifdef SDIZO_HEAP_STATS
+      this->stats = {};
+#endif
+    }
+
     // Finds element in table.
     // If element is in the table, returns it's index, -1 otherwise.
     int32_t find(ElemType elem) const;
 
   private:
+    // Returns position of node in heap or -1 if node was not
+    // discovered since last reset or was already popped.
+    inline int32_t position(int32_t node) const noexcept
+    {return this->epoch_table[node] == this->epoch ?
+            this->lookup_table[node] : -1;}
+
+    static inline entry_t make_key(ElemType element) noexcept
+    {
+      if constexpr (layout == HeapLayout::packed)
+        return (uint64_t(uint32_t(element.cost) ^ sign_bit) << 32) |
+               uint32_t(element.node);
+      else
+        return element.cost;
+    }
+
+    inline int32_t node_at(int32_t index) const noexcept
+    {
+      if constexpr (layout == HeapLayout::packed)
+        return int32_t(uint32_t(this->array[index]));
+      else
+        return this->node_array[index];
+    }
+
+    inline int32_t cost_at(int32_t index) const noexcept
+    {
+      if constexpr (layout == HeapLayout::packed)
+        return int32_t(uint32_t(this->array[index] >> 32) ^ sign_bit);
+      else
+        return this->array[index];
+    }
+
+    // Writes element at index and updates its position in lookup.
+    inline void set_entry(int32_t index, entry_t key, int32_t node) noexcept
+    {
+      this->array[index] = key;
+      if constexpr (layout == HeapLayout::soa)
+        this->node_array[index] = node;
+      this->lookup_table[node] = index;
+    }
+
+    // Swaps entries inside heap together with their lookup positions.
+    void swap_entries(int32_t i, int32_t j) noexcept;
+
     void heapify(int32_t index) noexcept;
     void heapify_down(int32_t index) noexcept;
     void heapify_up(int32_t index) noexcept;
 
     void insert(ElemType element) noexcept;
 
+    // Invalidates positions of all nodes at once. Epoch 0 is never
+    // current, so zeroed stamps of fresh tables are invalid.
+    void next_epoch() noexcept;
+
     // Reallocs heap to new, bigger space.
     // New space is bigger by Heap::expand_size.
     void expand() noexcept;
@@ -152,10 +218,62 @@ class LookupHeap
     void removeAt(int32_t index);
 };
 
+class DijkstraSolver
+{
+private:
+  // Query workspace, kept alive between queries and reset in O(1)
+  sdizo2::CostSourceTable cst;
+  LookupHeap<> node_heap;
+
+  sdizo::List<sdizo::ListNode<MSTListNode>> *edge_list;
+  sdizo2::MSTMatrix node_matrix;
+
+  int32_t size;
+  int32_t starting_node;
+
+public:
+  DijkstraSolver(int32_t size) noexcept;
+  DijkstraSolver(DijkstraSolver&& solver) noexcept = default;
+  ~DijkstraSolver() noexcept;
+
+  void loadFromFile(const char *filename);
+  static DijkstraSolver buildFromFile(const char *filename);
+
+  int32_t generate(int32_t node_cnt, double density) noexcept;
+  void resize(int32_t newsize) noexcept;
+
+  void solve() noexcept;
+  void solve_matrix() noexcept;
+
+  // Finds paths from given source without displaying them,
+  // results are left in cost source table.
+  // Throws std::out_of_range if source is not node of graph.
+  void solve_from(int32_t source);
+
+  inline sdizo2::CostSourceTable& get_cost_source_table() noexcept
+  {return this->cst;}
+
+  // Counters of node heap, all zero if SDIZO_HEAP_STATS is not defined.
+  inline sdizo::HeapStats get_heap_stats() const noexcept
+  {return this->node_heap.get_stats();}
+
+  inline void reset_heap_stats() noexcept
+  {this->node_heap.reset_stats();}
+
+  void display() noexcept;
+  void display_list() noexcept;
+  void display_matrix() noexcept;
+
+private:
+  void set_starting_node(int32_t snode) noexcept;
+};
+
 }; // namespace sdizo2
 
+template<sdizo2::dijkstra::HeapLayout layout>
 inline void printHeap
-(const sdizo2::dijkstra::LookupHeap *heap, int index, int space) noexcept
+(const sdizo2::dijkstra::LookupHeap<layout> *heap, int index, int space)
+noexcept
 {
   if (index >= heap->get_ssize())
     return;
@@ -166,12 +284,16 @@ inline void printHeap
 
 
   printf("\n%*s%i\n", space - shift_width, " ",
-         sdizo::key(heap->at(index)));
+         heap->at(index).cost);
 
   printHeap(heap, LEFT(index), space);
 }
 
-inline void print2D(const sdizo2::dijkstra::LookupHeap *heap) noexcept
+template<sdizo2::dijkstra::HeapLayout layout>
+inline void print2D(const sdizo2::dijkstra::LookupHeap<layout> *heap) noexcept
 {
   printHeap(heap, 0, 0);
 }
+
+#include "lookupheap.tcc"
+
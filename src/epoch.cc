@@ -0,0 +1,107 @@
+#include "epoch.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <fmt/format.h>
+
+using sdizo::EpochManager;
+
+// Slot indices are shared by all managers, thread gives its index
+// back on exit.
+static std::atomic<bool> slot_taken[EpochManager::max_threads];
+
+namespace{
+  struct ThreadSlot
+  {
+    int32_t index = -1;
+
+    ~ThreadSlot()
+    {
+      if(this->index >= 0)
+        slot_taken[this->index].store(false, std::memory_order_release);
+    }
+  };
+}
+
+static thread_local ThreadSlot thread_slot;
+
+static int32_t thread_index()
+{
+  if(thread_slot.index >= 0)
+    return thread_slot.index;
+
+  for(int32_t i = 0; i < EpochManager::max_threads; ++i)
+  {
+    bool expected = false;
+    if(slot_taken[i].compare_exchange_strong(expected, true))
+    {
+      thread_slot.index = i;
+      return i;
+    }
+  }
+
+  throw std::runtime_error(fmt::format(
+    "More than {} threads use epochs", EpochManager::max_threads));
+}
+
+sdizo::EpochManager::EpochManager() noexcept
+:epoch{1}
+{}
+
+sdizo::EpochManager::~EpochManager() noexcept
+{
+  for(auto &slot : this->slots)
+    for(auto &retired : slot.retired)
+      retired.deleter(retired.object);
+}
+
+EpochManager::Guard sdizo::EpochManager::pin()
+{
+  auto &slot = this->slots[thread_index()].epoch;
+
+  if(slot.load(std::memory_order_relaxed) != 0)
+    return Guard(nullptr);
+
+  // Sequentially consistent store orders pin before loads of shared
+  // pointers, so writer either sees pin or reader sees new pointers
+  slot.store(this->epoch.load(), std::memory_order_seq_cst);
+  return Guard(&slot);
+}
+
+void sdizo::EpochManager::retire(void *object, void (*deleter)(void*))
+{
+  auto &slot = this->slots[thread_index()];
+
+  // Threads pinned later see epoch greater than the retire one
+  slot.retired.push_back({this->epoch.fetch_add(1), object, deleter});
+
+  if(slot.retired.size() >= collect_threshold)
+    this->collect(slot);
+}
+
+void sdizo::EpochManager::collect()
+{
+  this->collect(this->slots[thread_index()]);
+}
+
+void sdizo::EpochManager::collect(Slot &owned) noexcept
+{
+  auto oldest = this->epoch.load();
+  for(auto &slot : this->slots)
+  {
+    auto pinned = slot.epoch.load();
+    if(pinned != 0)
+      oldest = std::min(oldest, pinned);
+  }
+
+  // Objects retired before oldest pinned epoch are unreachable
+  auto &retired = owned.retired;
+  auto reachable = std::partition(retired.begin(), retired.end(),
+                                  [oldest](const Retired &retired){
+    return retired.epoch >= oldest;
+  });
+
+  for(auto it = reachable; it != retired.end(); ++it)
+    it->deleter(it->object);
+
+  retired.erase(reachable, retired.end());
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+
+namespace sdizo{
+  // Epoch based reclamation. Reader pins current epoch for as long as
+  // it holds pointers to shared objects. Objects retired by writers are
+  // deleted once no thread pinned at their retire epoch or earlier is
+  // left pinned. Every thread keeps its own list of retired objects,
+  // so neither pin nor retire takes a lock.
+  class EpochManager
+  {
+    public:
+      // Maximum count of threads using epochs at the same time.
+      static constexpr int32_t max_threads = 128;
+
+      // Keeps thread pinned while alive.
+      class Guard
+      {
+        private:
+          std::atomic<uint64_t> *slot;
+
+        public:
+          inline Guard(std::atomic<uint64_t> *slot) noexcept
+          :slot{slot} {}
+
+          Guard(const Guard&) = delete;
+
+          inline Guard(Guard &&guard) noexcept
+          :slot{guard.slot}
+          {guard.slot = nullptr;}
+
+          inline ~Guard() noexcept
+          {
+            if(this->slot != nullptr)
+              this->slot->store(0, std::memory_order_release);
+          }
+      };
+
+    private:
+      // Retired objects are collected once this many are waiting.
+      static constexpr std::size_t collect_threshold = 64;
+
+      struct Retired
+      {
+        uint64_t epoch;
+        void *object;
+        void (*deleter)(void*);
+      };
+
+      // Owned by one thread at a time, only epoch is read by others.
+      struct alignas(64) Slot
+      {
+        // Epoch thread is pinned at, 0 if not pinned.
+        std::atomic<uint64_t> epoch{0};
+        std::vector<Retired> retired;
+      };
+
+      std::atomic<uint64_t> epoch;
+      Slot slots[max_threads];
+
+    public:
+      EpochManager() noexcept;
+      EpochManager(const EpochManager&) = delete;
+      // Deletes all retired objects, no thread can be pinned.
+      ~EpochManager() noexcept;
+
+      // Pinning thread already pinned does nothing. Throws
+      // std::runtime_error if more than max_threads threads use epochs.
+      Guard pin();
+
+      // Deletes object once threads that could see it are unpinned.
+      template<typename T>
+      inline void retire(T *object)
+      {
+        this->retire(object, [](void *object){
+          delete static_cast<T*>(object);
+        });
+      }
+
+      void retire(void *object, void (*deleter)(void*));
+
+      // Deletes objects retired by calling thread that no pinned
+      // thread can see anymore.
+      void collect();
+
+    private:
+      void collect(Slot &slot) noexcept;
+  };
+}
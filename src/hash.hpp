@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+
+namespace sdizo{
+
+// Finalizer of MurmurHash3. Mixes bits of key, so that similar keys
+// give unrelated hashes. It is bijection, so distinct keys never
+// collide.
+inline uint64_t mix_hash(uint64_t key) noexcept
+{
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return key;
+}
+
+} // namespace sdizo
@@ -0,0 +1,314 @@
+#include "hashset.hpp"
+#include "hash.hpp"
+#include <algorithm>
+#include <random>
+#include <fstream>
+#include <cstdio>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Bit i of masks below is set for slot i of group.
+struct sdizo::HashSet::Group
+{
+#ifdef __SSE2__
+  __m128i ctrl;
+
+  explicit Group(const int8_t *ctrl) noexcept
+  :ctrl{_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))}
+  {}
+
+  inline uint32_t match(int8_t value) const noexcept
+  {return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), this->ctrl));}
+
+  // Empty and deleted bytes are only negative ones
+  inline uint32_t match_free() const noexcept
+  {return _mm_movemask_epi8(this->ctrl);}
+#else
+  const int8_t *ctrl;
+
+  explicit Group(const int8_t *ctrl) noexcept
+  :ctrl{ctrl}
+  {}
+
+  inline uint32_t match(int8_t value) const noexcept
+  {
+    uint32_t mask = 0;
+    for(int32_t i = 0; i < group_width; ++i)
+      mask |= uint32_t(this->ctrl[i] == value) << i;
+
+    return mask;
+  }
+
+  inline uint32_t match_free() const noexcept
+  {
+    uint32_t mask = 0;
+    for(int32_t i = 0; i < group_width; ++i)
+      mask |= uint32_t(this->ctrl[i] < 0) << i;
+
+    return mask;
+  }
+#endif
+
+  inline uint32_t match_empty() const noexcept
+  {return this->match(ctrl_empty);}
+};
+
+// Low 7 bits go to control byte, rest picks start of probe sequence.
+static inline uint64_t hash(int32_t element) noexcept
+{
+  return sdizo::mix_hash(uint32_t(element));
+}
+
+static inline int8_t control(uint64_t hash) noexcept
+{
+  return hash & 0x7f;
+}
+
+sdizo::HashSet::HashSet() noexcept
+:ctrl{nullptr}, slots{nullptr}, capacity{0}, size{0}, growth_left{0}
+{}
+
+sdizo::HashSet::~HashSet() noexcept
+{
+  delete [] this->ctrl;
+  delete [] this->slots;
+}
+
+int32_t sdizo::HashSet::loadFromFile(const char *filename) noexcept
+{
+  std::ifstream file(filename);
+  int32_t num;
+  int32_t count;
+
+  file >> count;
+  this->reserve(this->size + std::max(count, 0));
+
+  while(file >> num && count)
+  {
+    this->insert(num);
+    --count;
+  }
+
+  return 0;
+}
+
+int32_t sdizo::HashSet::find(int32_t element, uint64_t hash) const noexcept
+{
+  if(this->capacity == 0)
+    return -1;
+
+  auto mask = this->capacity - 1;
+  int32_t position = (hash >> 7) & mask;
+
+  // Windows move by growing multiples of group width, which on power
+  // of two capacity reaches every slot
+  for(int32_t step = group_width;; step += group_width)
+  {
+    Group group(this->ctrl + position);
+
+    for(auto match = group.match(control(hash)); match; match &= match - 1)
+    {
+      auto index = (position + __builtin_ctz(match)) & mask;
+      if(this->slots[index] == element)
+        return index;
+    }
+
+    // Element would have been put into empty slot
+    if(group.match_empty())
+      return -1;
+
+    position = (position + step) & mask;
+  }
+}
+
+int32_t sdizo::HashSet::find_free(uint64_t hash) const noexcept
+{
+  auto mask = this->capacity - 1;
+  int32_t position = (hash >> 7) & mask;
+
+  for(int32_t step = group_width;; step += group_width)
+  {
+    auto match = Group(this->ctrl + position).match_free();
+    if(match)
+      return (position + __builtin_ctz(match)) & mask;
+
+    position = (position + step) & mask;
+  }
+}
+
+void sdizo::HashSet::set_ctrl(int32_t index, int8_t value) noexcept
+{
+  this->ctrl[index] = value;
+
+  if(index < group_width)
+    this->ctrl[this->capacity + index] = value;
+}
+
+void sdizo::HashSet::insert(int32_t element) noexcept
+{
+  auto element_hash = hash(element);
+  if(this->find(element, element_hash) >= 0)
+    return;
+
+  if(this->growth_left == 0)
+  {
+    // Table full of deleted slots is cleaned up without growing
+    if(this->size < max_load(this->capacity) / 2)
+      this->rehash(this->capacity);
+    else
+      this->rehash(std::max(group_width, this->capacity * 2));
+  }
+
+  auto index = this->find_free(element_hash);
+  if(this->ctrl[index] == ctrl_empty)
+    --this->growth_left;
+
+  this->set_ctrl(index, control(element_hash));
+  this->slots[index] = element;
+  ++this->size;
+}
+
+void sdizo::HashSet::remove(int32_t element) noexcept
+{
+  auto index = this->find(element, hash(element));
+  if(index < 0)
+    return;
+
+  auto mask = this->capacity - 1;
+  auto before = Group(this->ctrl + ((index - group_width) & mask))
+                  .match_empty();
+  auto after = Group(this->ctrl + index).match_empty();
+
+  // If empty slots around index are closer than group width, no window
+  // holding index was ever full, so no probe went past it
+  bool probed_past = !before || !after ||
+    __builtin_ctz(after) + __builtin_clz(before) - 16 >= group_width;
+
+  if(probed_past)
+    this->set_ctrl(index, ctrl_deleted);
+  else
+  {
+    this->set_ctrl(index, ctrl_empty);
+    ++this->growth_left;
+  }
+
+  --this->size;
+}
+
+void sdizo::HashSet::rehash(int32_t new_capacity) noexcept
+{
+  auto old_ctrl = this->ctrl;
+  auto old_slots = this->slots;
+  auto old_capacity = this->capacity;
+
+  this->capacity = new_capacity;
+  this->ctrl = new int8_t[new_capacity + group_width];
+  this->slots = new int32_t[new_capacity];
+  this->growth_left = max_load(new_capacity) - this->size;
+  std::fill(this->ctrl, this->ctrl + new_capacity + group_width, ctrl_empty);
+
+  for(int32_t i = 0; i < old_capacity; ++i)
+  {
+    if(old_ctrl[i] < 0)
+      continue;
+
+    auto index = this->find_free(hash(old_slots[i]));
+    this->set_ctrl(index, old_ctrl[i]);
+    this->slots[index] = old_slots[i];
+  }
+
+  delete [] old_ctrl;
+  delete [] old_slots;
+}
+
+void sdizo::HashSet::reserve(int32_t count) noexcept
+{
+  auto new_capacity = std::max(group_width, this->capacity);
+  while(max_load(new_capacity) < count)
+    new_capacity *= 2;
+
+  if(new_capacity != this->capacity)
+    this->rehash(new_capacity);
+}
+
+void sdizo::HashSet::generate
+(int32_t rand_range_begin, int32_t rand_range_end, int32_t size) noexcept
+{
+  std::random_device generator;
+  std::uniform_int_distribution<int32_t>
+   distribution(rand_range_begin, rand_range_end);
+
+  this->clear();
+  this->reserve(size);
+  for(int32_t i = 0; i < size; ++i)
+  {
+    this->insert(distribution(generator));
+  }
+}
+
+void sdizo::HashSet::clear() noexcept
+{
+  delete [] this->ctrl;
+  delete [] this->slots;
+
+  this->ctrl = nullptr;
+  this->slots = nullptr;
+  this->capacity = 0;
+  this->size = 0;
+  this->growth_left = 0;
+}
+
+bool sdizo::HashSet::contains(int32_t element) const noexcept
+{
+  return this->find(element, hash(element)) >= 0;
+}
+
+void sdizo::HashSet::display() const noexcept
+{
+  puts("===========================");
+  printf("[");
+  bool first = true;
+  for(int32_t i = 0; i < this->capacity; ++i)
+  {
+    if(this->ctrl[i] < 0)
+      continue;
+
+    printf(first ? "%i" : " %i", this->slots[i]);
+    first = false;
+  }
+  puts("]");
+  puts("===========================");
+}
+
+bool sdizo::HashSet::verify() const noexcept
+{
+  if(this->capacity == 0)
+    return this->size == 0;
+
+  int32_t full = 0;
+  int32_t deleted = 0;
+  for(int32_t i = 0; i < this->capacity; ++i)
+  {
+    if(this->ctrl[i] == ctrl_deleted)
+      ++deleted;
+
+    if(this->ctrl[i] < 0)
+      continue;
+
+    auto element_hash = hash(this->slots[i]);
+    if(this->ctrl[i] != control(element_hash) ||
+       this->find(this->slots[i], element_hash) != i)
+      return false;
+
+    ++full;
+  }
+
+  if(!std::equal(this->ctrl, this->ctrl + group_width,
+                 this->ctrl + this->capacity))
+    return false;
+
+  return full == this->size &&
+         this->growth_left == max_load(this->capacity) - full - deleted;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+
+namespace sdizo{
+  // Set of int32_t in open addressing hash table. Every slot has
+  // control byte, which is empty, deleted or low 7 bits of hash of
+  // element in slot. Lookup compares control bytes of group of 16
+  // slots at once and looks at elements only on match, so most of
+  // absent elements are rejected without touching slots at all.
+  // Inserting element already in set does nothing.
+  class HashSet
+  {
+    public:
+      static constexpr int32_t group_width = 16;
+
+    private:
+      static constexpr int8_t ctrl_empty = -128;
+      static constexpr int8_t ctrl_deleted = -2;
+
+      // Control bytes of group_width slots starting at some slot.
+      struct Group;
+
+      // Capacity + group_width bytes, last group_width bytes mirror
+      // first ones, so group starting at any slot can be loaded at once.
+      int8_t *ctrl;
+      int32_t *slots;
+      int32_t capacity;
+      int32_t size;
+      // Count of inserts into empty slots left before rehash.
+      int32_t growth_left;
+
+    public:
+      HashSet() noexcept;
+      HashSet(const HashSet&) = delete;
+      ~HashSet() noexcept;
+
+      int32_t loadFromFile(const char *filename) noexcept;
+      void insert(int32_t element) noexcept;
+      void remove(int32_t element) noexcept;
+      void generate(int32_t rand_range_begin, int32_t rand_range_end,
+                    int32_t size) noexcept;
+
+      // Makes room for count elements without rehashing.
+      void reserve(int32_t count) noexcept;
+
+      // Removes all elements and frees table
+      void clear() noexcept;
+      bool contains(int32_t element) const noexcept;
+
+      void display() const noexcept;
+
+      // Checks that all elements are reachable from their hash, control
+      // bytes match elements and mirrored bytes match first group.
+      bool verify() const noexcept;
+
+      inline int32_t get_size() const noexcept
+      {return this->size;}
+
+      inline int32_t get_capacity() const noexcept
+      {return this->capacity;}
+
+    private:
+      // Returns index of slot holding element or -1.
+      int32_t find(int32_t element, uint64_t hash) const noexcept;
+      // Returns index of first empty or deleted slot on probe sequence.
+      int32_t find_free(uint64_t hash) const noexcept;
+      void set_ctrl(int32_t index, int8_t value) noexcept;
+      // Moves elements to table of given capacity, dropping deleted slots.
+      void rehash(int32_t new_capacity) noexcept;
+
+      static inline int32_t max_load(int32_t capacity) noexcept
+      {return capacity - capacity / 8;}
+  };
+}
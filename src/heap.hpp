@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include "heapstats.hpp"
 
 namespace sdizo{
 
@@ -27,6 +28,10 @@ class Heap
     int32_t ssize;
     int32_t length;
 
+#ifdef SDIZO_HEAP_STATS
+    mutable HeapStats stats;
+#endif
+
   public:
     Heap() noexcept;
     Heap(Heap&& h) noexcept;
@@ -46,7 +51,7 @@ class Heap
     void removeAt(int32_t index);
 
     inline ElemType pop()
-    {ElemType ret = this->at(0); this->removeAt(0); return ret;}
+    {HEAP_STAT(pops); ElemType ret = this->at(0); this->removeAt(0); return ret;}
 
     void remove(ElemType element) noexcept;
 
@@ -75,6 +80,23 @@ class Heap
     inline bool is_empty() const noexcept
     {return this->ssize == 0;}
 
+    // Returns operation counters, all zero if SDIZO_HEAP_STATS is not defined.
+    inline HeapStats get_stats() const noexcept
+    {
+#ifdef SDIZO_HEAP_STATS
+      return this->stats;
+#else
+      return {};
+#endif
+    }
+
+    inline void reset_stats() noexcept
+    {
+#ifdef SDIZO_HEAP_STATS
+      this->stats = {};
+#endif
+    }
+
   private:
     void heapify(int32_t index) noexcept;
     void heapify_down(int32_t index) noexcept;
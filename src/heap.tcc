@@ -70,6 +70,8 @@ ElemType sdizo::Heap<ElemType, heap_t>::at(int32_t index) const
 template<typename ElemType, sdizo::HeapType heap_t>
 void sdizo::Heap<ElemType, heap_t>::insert(ElemType element)
 {
+  HEAP_STAT(inserts);
+
   if(this->ssize == this->length)
     this->expand();
 
@@ -95,6 +97,7 @@ void sdizo::Heap<ElemType, heap_t>::insert(ElemType element)
       break;
 
     this->array[i] = this->array[parent];
+    HEAP_STAT(sift_steps);
     i = parent;
     parent = PARENT(i);
   }
@@ -145,6 +148,8 @@ template<typename ElemType, sdizo::HeapType heap_t>
 bool sdizo::Heap<ElemType, heap_t>::contains(ElemType element)
 const noexcept
 {
+  HEAP_STAT(linear_finds);
+
   for(int32_t i = 0; i < this->ssize; ++i)
   {
     if(this->array[i] == element)
@@ -233,6 +238,8 @@ void sdizo::Heap<ElemType, heap_t>::heapify_down(int32_t index) noexcept
   if(extreme != index)
   {
     std::swap(this->array[extreme], this->array[index]);
+    HEAP_STAT(swaps);
+    HEAP_STAT(sift_steps);
     this->heapify_down(extreme);
   }
 }
@@ -257,6 +264,8 @@ void sdizo::Heap<ElemType, heap_t>::heapify_up(int32_t index) noexcept
       break;
 
     std::swap(this->array[parent], this->array[index]);
+    HEAP_STAT(swaps);
+    HEAP_STAT(sift_steps);
     index = parent;
     parent = PARENT(parent);
   }
@@ -268,6 +277,7 @@ void sdizo::Heap<ElemType, heap_t>::expand() noexcept
   int32_t new_size = this->length +
                      sdizo::Heap<ElemType, heap_t>::expand_size;
   ElemType *new_array = new ElemType[new_size];
+  HEAP_STAT(reallocations);
 
   // copy old part of heap
   std::copy(this->array, this->array + this->length, new_array);
@@ -281,6 +291,8 @@ void sdizo::Heap<ElemType, heap_t>::expand() noexcept
 template<typename ElemType, sdizo::HeapType heap_t>
 int32_t sdizo::Heap<ElemType, heap_t>::find(ElemType elem) const noexcept
 {
+  HEAP_STAT(linear_finds);
+
   for(int32_t i = 0; i < this->ssize; ++i)
   {
     if(this->array[i] == elem)
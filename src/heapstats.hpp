@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+
+namespace sdizo{
+
+// Counters of heap operations.
+// Collected only when compiled with SDIZO_HEAP_STATS defined,
+// otherwise counting compiles to nothing and all counters stay zero.
+struct HeapStats
+{
+  uint64_t inserts = 0;
+  uint64_t pops = 0;
+  // Levels element traveled while restoring heap property.
+  uint64_t sift_steps = 0;
+  uint64_t swaps = 0;
+  // Number of times heap was relocated by expand().
+  uint64_t reallocations = 0;
+  // Number of O(n) scans done to find element.
+  uint64_t linear_finds = 0;
+};
+
+} // namespace sdizo
+
+#ifndef HEAP_STAT
+#ifdef SDIZO_HEAP_STATS
+#define HEAP_STAT(counter) (++this->stats.counter)
+#else
+#define HEAP_STAT(counter) ((void)0)
+#endif
+#endif
@@ -0,0 +1,360 @@
+#pragma once
+#include "dijkstra.hpp"
+#include "costsourcetable.hpp"
+#include "treeprinter.hpp"
+#include "common.hpp"
+#include <stdexcept>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <cassert>
+#include <fstream>
+#include <fmt/format.h>
+
+#ifndef HEAP_MACROS
+#define HEAP_MACROS
+#define PARENT(i) ((i - 1)>>1)
+#define LEFT(i) ((i<<1)+1)
+#define RIGHT(i) ((i+1)<<1)
+#endif
+
+template<sdizo2::dijkstra::HeapLayout layout>
+sdizo2::dijkstra::LookupHeap<layout>::LookupHeap
+(int32_t size) noexcept
+:array{new entry_t[size]},
+ node_array{layout == HeapLayout::soa ? new int32_t[size] : nullptr},
+ lookup_table{new int32_t[size]},
+ epoch_table{new uint32_t[size]()},
+ epoch{1},
+ ssize{0},
+ length{size}
+{}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+sdizo2::dijkstra::LookupHeap<layout>::LookupHeap(LookupHeap&& h) noexcept
+:array(h.array), node_array(h.node_array), lookup_table(h.lookup_table),
+ epoch_table(h.epoch_table), epoch(h.epoch), ssize(h.ssize), length(h.length)
+{
+  h.array = nullptr;
+  h.node_array = nullptr;
+  h.lookup_table = nullptr;
+  h.epoch_table = nullptr;
+  h.epoch = 0;
+  h.ssize = 0;
+  h.length = 0;
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+sdizo2::dijkstra::LookupHeap<layout>::~LookupHeap() noexcept
+{
+  delete [] this->array;
+  delete [] this->node_array;
+  delete [] this->lookup_table;
+  delete [] this->epoch_table;
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+typename sdizo2::dijkstra::LookupHeap<layout>::ElemType
+sdizo2::dijkstra::LookupHeap<layout>::at(int32_t index) const
+{
+  if(index >= this->ssize)
+    throw std::out_of_range("Cannot read from index exceeding span of heap.");
+
+  return {this->node_at(index), this->cost_at(index)};
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::removeAt(int32_t index)
+{
+  if(this->ssize <= 0)
+    return;
+
+  if(index >= this->ssize)
+    throw std::out_of_range("Cannot remove past last element.");
+
+  auto removed_node = this->node_at(index);
+
+  // Last one will go in place of removed
+  this->swap_entries(index, this->ssize-1);
+
+  // Removed one is no longer in heap
+  this->lookup_table[removed_node] = -1;
+
+  --this->ssize;
+
+  this->heapify(index);
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::clear() noexcept
+{
+  this->next_epoch();
+  this->ssize = 0;
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::display() const noexcept
+{
+  puts("Min heap");
+
+  printf("{ ");
+  for(int32_t i = 0; i < this->ssize; ++i)
+  {
+    printf("%i ", this->cost_at(i));
+  }
+  printf("} SIZE: %i\n", this->ssize);
+
+  puts("===========================");
+  print2D(this);
+  puts("===========================");
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::heapify(int32_t index) noexcept
+{
+  this->heapify_down(index);
+  this->heapify_up(index);
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::heapify_down(int32_t index)
+noexcept
+{
+  while(index < this->ssize/2)
+  {
+    auto left = LEFT(index);
+    auto right = RIGHT(index);
+
+    // Smallest of all
+    auto extreme = index;
+
+    if(this->array[left] < this->array[index])
+      extreme = left;
+
+    if(right < this->ssize && this->array[right] < this->array[extreme])
+      extreme = right;
+
+    if(extreme == index)
+      break;
+
+    this->swap_entries(extreme, index);
+    HEAP_STAT(sift_steps);
+    index = extreme;
+  }
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::heapify_up(int32_t index) noexcept
+{
+  auto parent = PARENT(index);
+
+  while(parent >= 0)
+  {
+    bool heap_property_satisfied = this->array[index] > this->array[parent];
+
+    if (heap_property_satisfied)
+      break;
+
+    this->swap_entries(parent, index);
+    HEAP_STAT(sift_steps);
+
+    index = parent;
+    parent = PARENT(parent);
+  }
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::swap_entries
+(int32_t i, int32_t j) noexcept
+{
+  // Fix lookup_table, swap positions
+  std::swap(this->lookup_table[this->node_at(i)],
+            this->lookup_table[this->node_at(j)]);
+
+  // Swap inside heap
+  std::swap(this->array[i], this->array[j]);
+  HEAP_STAT(swaps);
+
+  if constexpr (layout == HeapLayout::soa)
+    std::swap(this->node_array[i], this->node_array[j]);
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::insert(ElemType element) noexcept
+{
+  HEAP_STAT(inserts);
+
+  if(this->ssize == this->length)
+    this->expand();
+
+  auto key = make_key(element);
+  auto i = this->ssize;
+  auto parent = PARENT(i);
+
+  while(i > 0)
+  {
+    bool heap_property_satisfied = this->array[parent] < key;
+
+    if (heap_property_satisfied)
+      break;
+
+    // Make place for current inserting element,
+    // position of moved node is updated
+    this->set_entry(i, this->array[parent], this->node_at(parent));
+    HEAP_STAT(sift_steps);
+
+    i = parent;
+    parent = PARENT(i);
+  }
+
+  // Insert element and update its position
+  this->set_entry(i, key, element.node);
+  this->epoch_table[element.node] = this->epoch;
+
+  ++this->ssize;
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::expand() noexcept
+{
+  // Realloc heap
+  int32_t new_size = this->length + expand_size;
+  entry_t *new_array = new entry_t[new_size];
+  HEAP_STAT(reallocations);
+
+  // copy old part of heap
+  std::copy(this->array, this->array + this->length, new_array);
+
+  delete [] this->array;
+  this->array = new_array;
+
+  if constexpr (layout == HeapLayout::soa)
+  {
+    int32_t *new_nodes = new int32_t[new_size];
+
+    std::copy(this->node_array, this->node_array + this->length, new_nodes);
+
+    delete [] this->node_array;
+    this->node_array = new_nodes;
+  }
+
+  // Realloc lookup_table
+  int32_t *new_lookup = new int32_t[new_size];
+
+  // copy old part of heap
+  std::copy(this->lookup_table,
+            this->lookup_table + this->length,
+            new_lookup);
+
+  delete [] this->lookup_table;
+  this->lookup_table = new_lookup;
+
+  // Realloc epoch_table, new entries are never stamped
+  uint32_t *new_epoch = new uint32_t[new_size]();
+
+  std::copy(this->epoch_table,
+            this->epoch_table + this->length,
+            new_epoch);
+
+  delete [] this->epoch_table;
+  this->epoch_table = new_epoch;
+
+  this->length = new_size;
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+int32_t sdizo2::dijkstra::LookupHeap<layout>::find(ElemType elem) const
+{
+  if(elem.node >= this->length|| elem.node < 0)
+    throw std::out_of_range("Tried finding node out of range.");
+
+  return this->position(elem.node);
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+bool sdizo2::dijkstra::LookupHeap<layout>::verify() const noexcept
+{
+  for(int32_t i = 0; i < this->ssize/2; ++i)
+  {
+    auto left = LEFT(i);
+    auto right = RIGHT(i);
+
+    if(left < this->ssize && this->array[i] > this->array[left])
+      return false;
+
+    if(right < this->ssize && this->array[i] > this->array[right])
+      return false;
+  }
+
+  return true;
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::reset(int32_t starting_node)
+{
+  if(starting_node >= this->length || starting_node < 0)
+    throw std::out_of_range(fmt::format("Starting node out of range, "
+      "expected in range [0,{}), got {}", this->length, starting_node));
+
+  // Invalidate whole lookup table at once
+  this->next_epoch();
+
+  this->ssize = 0;
+  this->insert({starting_node, 0});
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::next_epoch() noexcept
+{
+  ++this->epoch;
+
+  // On wrap around old stamps could become valid again
+  if(this->epoch == 0)
+  {
+    std::fill(this->epoch_table, this->epoch_table + this->length, 0);
+    this->epoch = 1;
+  }
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::resize(int32_t newsize) noexcept
+{
+  delete [] this->array;
+  delete [] this->node_array;
+  delete [] this->lookup_table;
+  delete [] this->epoch_table;
+
+  this->array = new entry_t[newsize];
+  this->node_array =
+    layout == HeapLayout::soa ? new int32_t[newsize] : nullptr;
+  this->lookup_table = new int32_t[newsize];
+  this->epoch_table = new uint32_t[newsize]();
+  this->epoch = 1;
+
+  this->ssize = 0;
+  this->length = newsize;
+}
+
+template<sdizo2::dijkstra::HeapLayout layout>
+void sdizo2::dijkstra::LookupHeap<layout>::update(int32_t node, int32_t cost)
+{
+  if(node >= this->length || node < 0)
+    throw std::out_of_range(
+      fmt::format("Tried updating node that is out of range in lookup,"
+      " expected in range [0,{}), got {}", this->length, node));
+
+  auto node_index = this->position(node);
+
+  // Node seen for the first time is inserted lazily.
+  // If node no longer in heap, but updated it must be
+  // reinserted into heap, all paths comming from it must
+  // be analyzed once more
+  if(node_index >= this->ssize || node_index < 0)
+  {
+    this->insert({node, cost});
+    return;
+  }
+
+  this->array[node_index] = make_key({node, cost});
+  this->heapify(node_index);
+}
@@ -4,7 +4,11 @@
 #include "heap.hpp"
 #include "tree.hpp"
 #include "redblacktree.hpp"
+#include "bplustree.hpp"
+#include "vanemdeboastree.hpp"
+#include "hashset.hpp"
 #include "test.hpp"
+#include "benchmarks.hpp"
 #include "mst.hpp"
 #include "dijkstra.hpp"
 #include "bellman-ford.hpp"
@@ -22,12 +26,35 @@ void run_tests()
   TEST("Array test", run_array_tests);
   TEST("List test", run_list_tests);
   TEST("Heap test", run_heap_tests);
+  TEST("Lookup heap test", run_lookup_heap_tests);
   TEST("BST test", run_bst_tests);
   TEST("RBT test", run_rbt_tests);
+  TEST("B+tree test", run_bplustree_tests);
+  TEST("vEB tree test", run_veb_tests);
+  TEST("Hash set test", run_hash_set_tests);
+  TEST("Skip list test", run_skiplist_tests);
   TEST("Disjoint sets test", run_disjoint_set_tests);
   TEST("Templatize tests", run_templatize_tests);
 }
 
+void run_benchmarks()
+{
+  using namespace sdizo::benchmarks;
+  constexpr const char *f_name = "bench_output.txt";
+
+  bench_tree_zipf(f_name, 1000000, 10000000, 1.0);
+  bench_rbt_layout(f_name, 1000000);
+  bench_rbt_set_operations(f_name, 1000000);
+  bench_rbt_sequential_insert(f_name, 1000000);
+  bench_rbt_concurrent_search(f_name, 10000000, 1000000);
+  bench_rbt_filter(f_name, 1000000, 10000000);
+  bench_veb(f_name, 1000000);
+  bench_hash_set(f_name, 1000000);
+  bench_skiplist_concurrent(f_name, 1000000, 1000000);
+  bench_disjoint_set(f_name, 1000000, 4000000);
+  bench_disjoint_set_concurrent(f_name, 1000000, 4000000);
+}
+
 namespace sdizo{
 void menu_array(sdizo::Array &array)
 {
@@ -270,7 +297,9 @@ void menu_heap(sdizo::Heap<int32_t> &heap)
   } while (option != '0');
 }
 
-void menu_redblacktree(sdizo::RedBlackTree &tree)
+// Shared by sets with RedBlackTree interface.
+template<typename Tree>
+void menu_set(Tree &tree, const char *title)
 {
   using namespace std;
   char option;
@@ -279,7 +308,7 @@ void menu_redblacktree(sdizo::RedBlackTree &tree)
 
   do
   {
-    puts("--- Drzewo czerwono czarne ---");
+    puts(fmt::format("--- {} ---", title).c_str());
     puts("1.Wczytaj z pliku");
     puts("2.Usun");
     puts("3.Wstaw");
@@ -343,6 +372,9 @@ void menu()
   sdizo::List<sdizo::ListNode<int32_t>> list;
   sdizo::Heap<int32_t> heap;
   sdizo::RedBlackTree tree;
+  sdizo::BPlusTree bplustree;
+  sdizo::VanEmdeBoasTree vebtree;
+  sdizo::HashSet hashset;
 
   char option;
   do
@@ -353,6 +385,9 @@ void menu()
     puts("2.Lista");
     puts("3.Kopiec");
     puts("4.Drzewo czerwono czarne");
+    puts("5.B+ drzewo");
+    puts("6.Drzewo van Emde Boasa");
+    puts("7.Tablica mieszajaca");
     puts("0.Wyjscie");
     puts("Podaj opcje:");
     GET_OPTION(option);
@@ -372,7 +407,19 @@ void menu()
         break;
 
       case '4':
-        menu_redblacktree(tree);
+        menu_set(tree, "Drzewo czerwono czarne");
+        break;
+
+      case '5':
+        menu_set(bplustree, "B+ drzewo");
+        break;
+
+      case '6':
+        menu_set(vebtree, "Drzewo van Emde Boasa");
+        break;
+
+      case '7':
+        menu_set(hashset, "Tablica mieszajaca");
         break;
     }
 
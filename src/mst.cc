@@ -384,11 +384,10 @@ void sdizo2::KruskalSolver::list_solve() noexcept
   while(node_cnt != this->size && !this->edge_heap.is_empty())
   {
     auto edge = this->edge_heap.pop();
-    if(ds.findSet(edge.v1) == ds.findSet(edge.v2))
+    if(!ds.unionSet(edge.v1, edge.v2))
       continue;
 
     mst_list.add(edge);
-    ds.unionSet(ds.get(edge.v1), ds.get(edge.v2));
   }
 }
 
@@ -401,11 +400,10 @@ void sdizo2::KruskalSolver::matrix_solve() noexcept
   while(node_cnt != this->size && !this->edge_heap.is_empty())
   {
     auto edge = this->edge_heap.pop();
-    if(ds.findSet(edge.v1) == ds.findSet(edge.v2))
+    if(!ds.unionSet(edge.v1, edge.v2))
       continue;
 
     mst_matrix.add(edge);
-    ds.unionSet(ds.get(edge.v1), ds.get(edge.v2));
   }
 }
 
@@ -629,3 +627,193 @@ void sdizo2::disjoint_set::DisjointSet::reset(int32_t current_size) noexcept
   for(auto i = 0; i < this->size; ++i)
     this->makeSet(i);
 }
+
+sdizo2::disjoint_set::FlatDisjointSet::FlatDisjointSet(int32_t size) noexcept
+: parents(new int32_t[size]), size(size)
+{
+  for(auto i = 0; i < size; ++i)
+    this->makeSet(i);
+}
+
+sdizo2::disjoint_set::FlatDisjointSet::FlatDisjointSet
+(FlatDisjointSet&& ds) noexcept
+: parents(ds.parents), size(ds.size)
+{
+  ds.parents = nullptr;
+  ds.size = 0;
+}
+
+sdizo2::disjoint_set::FlatDisjointSet::~FlatDisjointSet() noexcept
+{
+  delete [] this->parents;
+}
+
+void sdizo2::disjoint_set::FlatDisjointSet::makeSet(int32_t i) noexcept
+{
+  assert(i < this->size);
+  assert(i >= 0);
+
+  this->parents[i] = -1;
+}
+
+bool sdizo2::disjoint_set::FlatDisjointSet::unionSet
+(int32_t index1, int32_t index2) noexcept
+{
+  auto root1 = this->findSet(index1);
+  auto root2 = this->findSet(index2);
+
+  if(root1 == root2)
+    return false;
+
+  this->linkSet(root1, root2);
+  return true;
+}
+
+void sdizo2::disjoint_set::FlatDisjointSet::linkSet
+(int32_t root1, int32_t root2) noexcept
+{
+  assert(this->parents[root1] < 0);
+  assert(this->parents[root2] < 0);
+
+  // Sizes are negative, lower one is bigger set
+  if(this->parents[root1] > this->parents[root2])
+    std::swap(root1, root2);
+
+  this->parents[root1] += this->parents[root2];
+  this->parents[root2] = root1;
+}
+
+int32_t sdizo2::disjoint_set::FlatDisjointSet::findSet(int32_t i) noexcept
+{
+  assert(i < this->size);
+  assert(i >= 0);
+
+  // Every other element on path is linked to its grandparent
+  while(this->parents[i] >= 0)
+  {
+    auto parent = this->parents[i];
+    if(this->parents[parent] < 0)
+      return parent;
+
+    this->parents[i] = this->parents[parent];
+    i = this->parents[parent];
+  }
+
+  return i;
+}
+
+void sdizo2::disjoint_set::FlatDisjointSet::display() noexcept
+{
+  for(auto i = 0; i < this->size; ++i)
+  {
+    fmt::print("{} -> ", i);
+
+    for(auto node = i; this->parents[node] >= 0;)
+    {
+      node = this->parents[node];
+      fmt::print("{} -> ", node);
+    }
+
+    fmt::print("self\n\n");
+  }
+}
+
+void sdizo2::disjoint_set::FlatDisjointSet::reset(int32_t current_size) noexcept
+{
+  if(this->size != current_size)
+  {
+    delete [] this->parents;
+    this->parents = new int32_t[current_size];
+    this->size = current_size;
+  }
+
+  for(auto i = 0; i < this->size; ++i)
+    this->makeSet(i);
+}
+
+sdizo2::disjoint_set::ConcurrentDisjointSet::ConcurrentDisjointSet
+(int32_t size) noexcept
+: parents(new std::atomic<int32_t>[size]), size(size)
+{
+  for(auto i = 0; i < size; ++i)
+    this->parents[i].store(i, std::memory_order_relaxed);
+}
+
+sdizo2::disjoint_set::ConcurrentDisjointSet::~ConcurrentDisjointSet() noexcept
+{
+  delete [] this->parents;
+}
+
+bool sdizo2::disjoint_set::ConcurrentDisjointSet::unionSet
+(int32_t index1, int32_t index2) noexcept
+{
+  while(true)
+  {
+    auto root1 = this->findSet(index1);
+    auto root2 = this->findSet(index2);
+
+    if(root1 == root2)
+      return false;
+
+    // Root of lower priority goes under the other one
+    if(priority(root1) > priority(root2))
+      std::swap(root1, root2);
+
+    // Fails if root1 got linked by other thread meanwhile
+    auto expected = root1;
+    if(this->parents[root1].compare_exchange_strong(expected, root2))
+      return true;
+  }
+}
+
+int32_t sdizo2::disjoint_set::ConcurrentDisjointSet::findSet(int32_t i) noexcept
+{
+  assert(i < this->size);
+  assert(i >= 0);
+
+  // Every element on path is linked to its grandparent, lost CAS only
+  // means other thread shortened path first
+  while(true)
+  {
+    auto parent = this->parents[i].load(std::memory_order_acquire);
+    auto grandparent = this->parents[parent].load(std::memory_order_acquire);
+
+    if(parent == grandparent)
+      return parent;
+
+    auto expected = parent;
+    this->parents[i].compare_exchange_weak(expected, grandparent);
+    i = parent;
+  }
+}
+
+bool sdizo2::disjoint_set::ConcurrentDisjointSet::sameSet
+(int32_t index1, int32_t index2) noexcept
+{
+  while(true)
+  {
+    auto root1 = this->findSet(index1);
+    auto root2 = this->findSet(index2);
+
+    if(root1 == root2)
+      return true;
+
+    // Roots were different while root1 was still root
+    if(this->parents[root1].load() == root1)
+      return false;
+  }
+}
+
+void sdizo2::disjoint_set::ConcurrentDisjointSet::reset
+(int32_t current_size) noexcept
+{
+  if(this->size != current_size)
+  {
+    delete [] this->parents;
+    this->parents = new std::atomic<int32_t>[current_size];
+    this->size = current_size;
+  }
+
+  for(auto i = 0; i < this->size; ++i)
+    this->parents[i].store(i, std::memory_order_relaxed);
+}
@@ -1,9 +1,11 @@
 #pragma once
 #include <cstdint>
+#include <atomic>
 #include <fmt/ostream.h>
 
 #include "list.hpp"
 #include "heap.hpp"
+#include "hash.hpp"
 
 namespace sdizo2{
 struct  Edge
@@ -88,6 +90,80 @@ public:
   void reset(int32_t current_size) noexcept;
 };
 
+// Disjoint set forest kept in single array of indices. Root holds
+// minus size of its set, other elements hold index of parent.
+class FlatDisjointSet
+{
+private:
+  int32_t *parents;
+  int32_t size;
+
+public:
+  FlatDisjointSet(int32_t size) noexcept;
+  FlatDisjointSet(FlatDisjointSet&& ds) noexcept;
+  FlatDisjointSet(const FlatDisjointSet&) = delete;
+  ~FlatDisjointSet() noexcept;
+
+  void makeSet(int32_t index) noexcept;
+
+  // Returns false if elements were already in the same set.
+  bool unionSet(int32_t index1, int32_t index2) noexcept;
+
+  // Hangs smaller set under bigger one, both have to be roots.
+  void linkSet(int32_t root1, int32_t root2) noexcept;
+
+  // Iterative, halves path on the way to root.
+  int32_t findSet(int32_t index) noexcept;
+
+  inline int32_t setSize(int32_t index) noexcept
+  {return -this->parents[this->findSet(index)];}
+
+  inline int32_t get_size() const noexcept
+  {return this->size;}
+
+  void display() noexcept;
+
+  void reset(int32_t current_size) noexcept;
+};
+
+// Disjoint set forest safe for concurrent unionSet and findSet from
+// many threads without locks. Roots are linked with single CAS in
+// random order of elements, which keeps trees shallow in expectation,
+// and finds split paths with CAS that may fail harmlessly.
+class ConcurrentDisjointSet
+{
+private:
+  // Root is its own parent.
+  std::atomic<int32_t> *parents;
+  int32_t size;
+
+public:
+  ConcurrentDisjointSet(int32_t size) noexcept;
+  ConcurrentDisjointSet(const ConcurrentDisjointSet&) = delete;
+  ~ConcurrentDisjointSet() noexcept;
+
+  // Returns false if elements were already in the same set. Of threads
+  // joining the same two sets only one gets true.
+  bool unionSet(int32_t index1, int32_t index2) noexcept;
+
+  // Root may stop being one right after it is returned.
+  int32_t findSet(int32_t index) noexcept;
+
+  bool sameSet(int32_t index1, int32_t index2) noexcept;
+
+  inline int32_t get_size() const noexcept
+  {return this->size;}
+
+  // No other thread may use set meanwhile.
+  void reset(int32_t current_size) noexcept;
+
+private:
+  // Random but fixed order in which roots are linked, distinct
+  // for distinct elements.
+  static inline uint64_t priority(int32_t index) noexcept
+  {return sdizo::mix_hash(uint32_t(index));}
+};
+
 }; // namespace disjoint_set
 
 struct MSTListNode
@@ -193,6 +269,13 @@ public:
   // Solving
   virtual void solve() noexcept;
 
+  // Counters of edge heap, all zero if SDIZO_HEAP_STATS is not defined.
+  inline sdizo::HeapStats get_heap_stats() const noexcept
+  {return this->edge_heap.get_stats();}
+
+  inline void reset_heap_stats() noexcept
+  {this->edge_heap.reset_stats();}
+
 protected:
   void prepareHeap() noexcept;
   void resize(int32_t) noexcept;
@@ -201,7 +284,7 @@ protected:
 class KruskalSolver :public MSTSolver
 {
 protected:
-  disjoint_set::DisjointSet ds;
+  disjoint_set::FlatDisjointSet ds;
 
 public:
   KruskalSolver() noexcept;
@@ -0,0 +1,486 @@
+#include "persistentredblacktree.hpp"
+#include <random>
+#include <fstream>
+
+using node_t = sdizo::PersistentRedBlackTree::node_t;
+using sdizo::NodeColor;
+
+static inline bool is_red(const node_t *node) noexcept
+{
+  return node != nullptr && node->color == NodeColor::red;
+}
+
+// Black height contributed by node itself.
+static inline int32_t blackness(const node_t *node) noexcept
+{
+  return is_red(node) ? 0 : 1;
+}
+
+sdizo::PersistentRedBlackTree::PersistentRedBlackTree() noexcept
+:root{nullptr}, height{0}, size{0}
+{}
+
+sdizo::PersistentRedBlackTree::PersistentRedBlackTree
+(const PersistentRedBlackTree &tree) noexcept
+:root{retain(tree.root)}, height{tree.height}, size{tree.size}
+{}
+
+sdizo::PersistentRedBlackTree::PersistentRedBlackTree
+(PersistentRedBlackTree &&tree) noexcept
+:root{tree.root}, height{tree.height}, size{tree.size}
+{
+  tree.root = nullptr;
+  tree.height = 0;
+  tree.size = 0;
+}
+
+sdizo::PersistentRedBlackTree& sdizo::PersistentRedBlackTree::operator=
+(const PersistentRedBlackTree &tree) noexcept
+{
+  // Retain first, tree can be this
+  auto root = retain(tree.root);
+  release(this->root);
+
+  this->root = root;
+  this->height = tree.height;
+  this->size = tree.size;
+  return *this;
+}
+
+sdizo::PersistentRedBlackTree& sdizo::PersistentRedBlackTree::operator=
+(PersistentRedBlackTree &&tree) noexcept
+{
+  if(this == &tree)
+    return *this;
+
+  release(this->root);
+
+  this->root = tree.root;
+  this->height = tree.height;
+  this->size = tree.size;
+
+  tree.root = nullptr;
+  tree.height = 0;
+  tree.size = 0;
+  return *this;
+}
+
+sdizo::PersistentRedBlackTree::~PersistentRedBlackTree() noexcept
+{
+  release(this->root);
+}
+
+int32_t sdizo::PersistentRedBlackTree::loadFromFile(const char *filename)
+noexcept
+{
+  std::ifstream file(filename);
+  int32_t num;
+  int32_t count;
+
+  file >> count;
+
+  while(file >> num && count)
+  {
+    this->insert(num);
+    --count;
+  }
+
+  return 0;
+}
+
+node_t* sdizo::PersistentRedBlackTree::retain(node_t *node) noexcept
+{
+  if(node != nullptr)
+    node->references.fetch_add(1, std::memory_order_relaxed);
+
+  return node;
+}
+
+void sdizo::PersistentRedBlackTree::release(node_t *node) noexcept
+{
+  if(node == nullptr)
+    return;
+
+  if(node->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    return;
+
+  release(node->left);
+  release(node->right);
+  delete node;
+}
+
+node_t* sdizo::PersistentRedBlackTree::unshare(node_t *node) noexcept
+{
+  // Nobody else can reach node, so nobody can start sharing it
+  if(node->references.load(std::memory_order_acquire) == 1)
+    return node;
+
+  auto copy = new node_t(node->value, node->color,
+                         retain(node->left), retain(node->right));
+  release(node);
+  return copy;
+}
+
+node_t* sdizo::PersistentRedBlackTree::rot_left(node_t *node) noexcept
+{
+  auto right = unshare(node->right);
+  node->right = right->left;
+  right->left = node;
+  return right;
+}
+
+node_t* sdizo::PersistentRedBlackTree::rot_right(node_t *node) noexcept
+{
+  auto left = unshare(node->left);
+  node->left = left->right;
+  left->right = node;
+  return left;
+}
+
+node_t* sdizo::PersistentRedBlackTree::balance(node_t *node) noexcept
+{
+  if(is_red(node))
+    return node;
+
+  node_t *top = nullptr;
+
+  // Red child and grandchild are on insert path, so already unshared
+  if(is_red(node->left))
+  {
+    if(is_red(node->left->left))
+      top = rot_right(node);
+    else if(is_red(node->left->right))
+    {
+      node->left = rot_left(node->left);
+      top = rot_right(node);
+    }
+  }
+
+  if(top == nullptr && is_red(node->right))
+  {
+    if(is_red(node->right->right))
+      top = rot_left(node);
+    else if(is_red(node->right->left))
+    {
+      node->right = rot_right(node->right);
+      top = rot_left(node);
+    }
+  }
+
+  if(top == nullptr)
+    return node;
+
+  top->color = NodeColor::red;
+  top->left->color = NodeColor::black;
+  top->right->color = NodeColor::black;
+  return top;
+}
+
+node_t* sdizo::PersistentRedBlackTree::insert(node_t *node, int32_t element)
+noexcept
+{
+  if(node == nullptr)
+    return new node_t(element, NodeColor::red, nullptr, nullptr);
+
+  node = unshare(node);
+
+  if(element < node->value)
+    node->left = insert(node->left, element);
+  else
+    node->right = insert(node->right, element);
+
+  return balance(node);
+}
+
+void sdizo::PersistentRedBlackTree::insert(int32_t element) noexcept
+{
+  this->root = insert(this->root, element);
+  this->blacken_root();
+  ++this->size;
+}
+
+void sdizo::PersistentRedBlackTree::blacken_root() noexcept
+{
+  if(!is_red(this->root))
+    return;
+
+  this->root = unshare(this->root);
+  this->root->color = NodeColor::black;
+  ++this->height;
+}
+
+// Sets links and color of node owned only by caller.
+static inline node_t* link(node_t *node, NodeColor color,
+                           node_t *left, node_t *right) noexcept
+{
+  node->color = color;
+  node->left = left;
+  node->right = right;
+  return node;
+}
+
+node_t* sdizo::PersistentRedBlackTree::join_right
+(node_t *left, int32_t left_height, node_t *middle,
+ node_t *right, int32_t right_height) noexcept
+{
+  if(!is_red(left) && left_height == right_height)
+    return link(middle, NodeColor::red, left, right);
+
+  auto node = unshare(left);
+  node->right = join_right(node->right, left_height - blackness(node),
+                           middle, right, right_height);
+
+  if(!is_red(node) && is_red(node->right) && is_red(node->right->right))
+  {
+    node->right->right = unshare(node->right->right);
+    node->right->right->color = NodeColor::black;
+    return rot_left(node);
+  }
+
+  return node;
+}
+
+node_t* sdizo::PersistentRedBlackTree::join_left
+(node_t *left, int32_t left_height, node_t *middle,
+ node_t *right, int32_t right_height) noexcept
+{
+  if(!is_red(right) && left_height == right_height)
+    return link(middle, NodeColor::red, left, right);
+
+  auto node = unshare(right);
+  node->left = join_left(left, left_height, middle,
+                         node->left, right_height - blackness(node));
+
+  if(!is_red(node) && is_red(node->left) && is_red(node->left->left))
+  {
+    node->left->left = unshare(node->left->left);
+    node->left->left->color = NodeColor::black;
+    return rot_right(node);
+  }
+
+  return node;
+}
+
+node_t* sdizo::PersistentRedBlackTree::join
+(node_t *left, int32_t left_height, node_t *middle,
+ node_t *right, int32_t right_height, int32_t &height) noexcept
+{
+  if(left_height > right_height)
+  {
+    auto node = join_right(left, left_height, middle, right, right_height);
+    height = left_height;
+
+    if(is_red(node) && is_red(node->right))
+    {
+      node->color = NodeColor::black;
+      ++height;
+    }
+
+    return node;
+  }
+
+  if(right_height > left_height)
+  {
+    auto node = join_left(left, left_height, middle, right, right_height);
+    height = right_height;
+
+    if(is_red(node) && is_red(node->left))
+    {
+      node->color = NodeColor::black;
+      ++height;
+    }
+
+    return node;
+  }
+
+  if(is_red(left) || is_red(right))
+  {
+    height = left_height + 1;
+    return link(middle, NodeColor::black, left, right);
+  }
+
+  height = left_height;
+  return link(middle, NodeColor::red, left, right);
+}
+
+node_t* sdizo::PersistentRedBlackTree::split_last
+(node_t *node, int32_t node_height, node_t *&last, int32_t &height) noexcept
+{
+  auto child_height = node_height - blackness(node);
+  // Copy of shared node takes references to its children
+  node = unshare(node);
+
+  if(node->right == nullptr)
+  {
+    last = node;
+    height = child_height;
+    return node->left;
+  }
+
+  int32_t rest_height;
+  auto rest = split_last(node->right, child_height, last, rest_height);
+  return join(node->left, child_height, node, rest, rest_height, height);
+}
+
+node_t* sdizo::PersistentRedBlackTree::join
+(node_t *left, int32_t left_height, node_t *right, int32_t right_height,
+ int32_t &height) noexcept
+{
+  if(left == nullptr)
+  {
+    height = right_height;
+    return right;
+  }
+
+  node_t *last;
+  int32_t rest_height;
+  auto rest = split_last(left, left_height, last, rest_height);
+  return join(rest, rest_height, last, right, right_height, height);
+}
+
+node_t* sdizo::PersistentRedBlackTree::remove
+(node_t *node, int32_t node_height, int32_t element, int32_t &height)
+noexcept
+{
+  auto child_height = node_height - blackness(node);
+  int32_t subtree_height;
+  // Unshared path nodes are reused as middle nodes of joins
+  node = unshare(node);
+
+  // Subtree changed on path is joined back with untouched one
+  if(element < node->value)
+  {
+    auto left = remove(node->left, child_height, element, subtree_height);
+    return join(left, subtree_height, node,
+                node->right, child_height, height);
+  }
+
+  if(node->value < element)
+  {
+    auto right = remove(node->right, child_height, element, subtree_height);
+    return join(node->left, child_height, node,
+                right, subtree_height, height);
+  }
+
+  auto result = join(node->left, child_height,
+                     node->right, child_height, height);
+  delete node;
+  return result;
+}
+
+void sdizo::PersistentRedBlackTree::remove(int32_t element) noexcept
+{
+  if(!this->contains(element))
+    return;
+
+  int32_t height;
+  this->root = remove(this->root, this->height, element, height);
+  this->height = height;
+  this->blacken_root();
+  --this->size;
+}
+
+void sdizo::PersistentRedBlackTree::generate
+(int32_t rand_range_begin, int32_t rand_range_end, int32_t size) noexcept
+{
+  std::random_device generator;
+  std::uniform_int_distribution<int32_t>
+   distribution(rand_range_begin, rand_range_end);
+
+  this->clear();
+  for(int32_t i = 0; i < size; ++i)
+  {
+    this->insert(distribution(generator));
+  }
+}
+
+void sdizo::PersistentRedBlackTree::clear() noexcept
+{
+  release(this->root);
+  this->root = nullptr;
+  this->height = 0;
+  this->size = 0;
+}
+
+const node_t* sdizo::PersistentRedBlackTree::search(int32_t element)
+const noexcept
+{
+  const node_t *node = this->root;
+  while(node != nullptr && node->value != element)
+  {
+    if(element < node->value)
+      node = node->left;
+    else
+      node = node->right;
+  }
+
+  return node;
+}
+
+void sdizo::PersistentRedBlackTree::display() const noexcept
+{
+  puts("===========================");
+  this->display(this->root, 0);
+  puts("===========================");
+}
+
+void sdizo::PersistentRedBlackTree::display(const node_t *node, int space)
+const noexcept
+{
+  constexpr int shift_width = 10;
+
+  if(node == nullptr)
+    return;
+
+  space += shift_width;
+
+  this->display(node->right, space);
+
+  if(is_red(node))
+    printf("\u001b[31m");
+
+  printf("\n%*s%i\n", space - shift_width, " ", node->value);
+
+  if(is_red(node))
+    printf("\u001b[0m");
+
+  this->display(node->left, space);
+}
+
+bool sdizo::PersistentRedBlackTree::verify() const noexcept
+{
+  const node_t *previous = nullptr;
+  int32_t count = 0;
+
+  if(is_red(this->root))
+    return false;
+
+  return this->verify(this->root, previous, count) == this->height &&
+         count == this->size;
+}
+
+int32_t sdizo::PersistentRedBlackTree::verify
+(const node_t *node, const node_t *&previous, int32_t &count) const noexcept
+{
+  if(node == nullptr)
+    return 0;
+
+  if(is_red(node) && (is_red(node->left) || is_red(node->right)))
+    return -1;
+
+  auto left_height = this->verify(node->left, previous, count);
+
+  // In order walk sees values in non decreasing order
+  if(previous != nullptr && node->value < previous->value)
+    return -1;
+
+  previous = node;
+  ++count;
+
+  auto right_height = this->verify(node->right, previous, count);
+
+  if(left_height < 0 || left_height != right_height)
+    return -1;
+
+  return left_height + blackness(node);
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <cstdint>
+#include <atomic>
+#include "redblacktree.hpp"
+
+namespace sdizo{
+  // Node shared between versions of PersistentRedBlackTree. Node is
+  // modified in place only while single version references it.
+  struct PersistentRedBlackNode
+  {
+    int32_t value;
+    NodeColor color;
+    // Count of versions and parent nodes pointing to this node.
+    std::atomic<int32_t> references;
+    PersistentRedBlackNode *left;
+    PersistentRedBlackNode *right;
+
+    PersistentRedBlackNode(int32_t value, NodeColor color,
+                           PersistentRedBlackNode *left,
+                           PersistentRedBlackNode *right) noexcept
+      :value{value}, color{color}, references{1}, left{left}, right{right} {}
+  };
+
+  // Red black tree where insert and remove copy only nodes on path from
+  // root, all other subtrees are shared with previous version.
+  // Copy of tree is O(1) snapshot that does not change when
+  // original is modified. Nodes have no parent pointers, missing
+  // child is nullptr. Equal elements are kept as separate elements.
+  class PersistentRedBlackTree
+  {
+    public:
+      using node_t = PersistentRedBlackNode;
+
+    private:
+      node_t *root;
+      // Count of black nodes on any path from root down.
+      int32_t height;
+      int32_t size;
+
+    public:
+      PersistentRedBlackTree() noexcept;
+      PersistentRedBlackTree(const PersistentRedBlackTree &tree) noexcept;
+      PersistentRedBlackTree(PersistentRedBlackTree &&tree) noexcept;
+      PersistentRedBlackTree& operator=(const PersistentRedBlackTree &tree)
+        noexcept;
+      PersistentRedBlackTree& operator=(PersistentRedBlackTree &&tree)
+        noexcept;
+      ~PersistentRedBlackTree() noexcept;
+
+      // Same as copy, named for readability at call sites.
+      inline PersistentRedBlackTree snapshot() const noexcept
+      {return *this;}
+
+      int32_t loadFromFile(const char *filename) noexcept;
+      void insert(int32_t element) noexcept;
+      void remove(int32_t element) noexcept;
+      void generate(int32_t rand_range_begin, int32_t rand_range_end,
+                    int32_t size) noexcept;
+
+      // Removes all elements, snapshots keep theirs.
+      void clear() noexcept;
+
+      // Returns nullptr if element is not in tree.
+      const node_t* search(int32_t element) const noexcept;
+      inline bool contains(int32_t element) const noexcept
+      {return this->search(element) != nullptr;}
+
+      void display() const noexcept;
+
+      // Checks order of values, colors, black height and size.
+      bool verify() const noexcept;
+
+      inline int32_t get_size() const noexcept
+      {return this->size;}
+
+      inline const node_t* get_root() const noexcept
+      {return this->root;}
+
+    private:
+      static node_t* retain(node_t *node) noexcept;
+      static void release(node_t *node) noexcept;
+      // Takes reference to node, returns node referenced only by caller,
+      // copying it if it is shared.
+      static node_t* unshare(node_t *node) noexcept;
+
+      static node_t* rot_left(node_t *node) noexcept;
+      static node_t* rot_right(node_t *node) noexcept;
+      // Okasaki rebalance of black node with red child and grandchild.
+      static node_t* balance(node_t *node) noexcept;
+
+      // All functions below take references to node arguments and
+      // return referenced result, heights are black heights.
+      static node_t* insert(node_t *node, int32_t element) noexcept;
+
+      // Joins trees with all left values not greater than middle and all
+      // right values not lower than middle, height is set to result
+      // height. Middle is node owned only by caller, its links and color
+      // are overwritten.
+      static node_t* join(node_t *left, int32_t left_height, node_t *middle,
+                          node_t *right, int32_t right_height,
+                          int32_t &height) noexcept;
+      static node_t* join_right(node_t *left, int32_t left_height,
+                                node_t *middle, node_t *right,
+                                int32_t right_height) noexcept;
+      static node_t* join_left(node_t *left, int32_t left_height,
+                               node_t *middle, node_t *right,
+                               int32_t right_height) noexcept;
+      // Join without middle node.
+      static node_t* join(node_t *left, int32_t left_height,
+                          node_t *right, int32_t right_height,
+                          int32_t &height) noexcept;
+      // Detaches maximum node of tree, rest is returned.
+      static node_t* split_last(node_t *node, int32_t node_height,
+                                node_t *&last, int32_t &height) noexcept;
+
+      // Element must be in subtree.
+      static node_t* remove(node_t *node, int32_t node_height,
+                            int32_t element, int32_t &height) noexcept;
+
+      // Makes root black, keeping height up to date.
+      void blacken_root() noexcept;
+
+      void display(const node_t *node, int space) const noexcept;
+      // Returns black height or -1 if subtree is not valid.
+      int32_t verify(const node_t *node, const node_t *&previous,
+                     int32_t &count) const noexcept;
+  };
+}
@@ -1,7 +1,12 @@
 #pragma once
 #include <cstdint>
 #include <cstdio>
-#include <limits>
+#include <cstddef>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+#include "bloomfilter.hpp"
+#include "hash.hpp"
 
 namespace sdizo{
   enum class NodeColor
@@ -9,28 +14,52 @@ namespace sdizo{
     red, black
   };
 
-  struct RedBlackNode
+  template<typename Value>
+  struct RedBlackMapped
   {
-    int32_t value;
+    Value mapped;
+  };
+
+  // Sets store no mapped value, empty base takes no space in node.
+  template<>
+  struct RedBlackMapped<void>
+  {};
+
+  // True if std::hash is enabled for T.
+  template<typename T, typename = void>
+  struct is_std_hashable : std::false_type {};
+
+  template<typename T>
+  struct is_std_hashable<T, std::void_t<decltype(
+    std::hash<T>{}(std::declval<const T&>()))>> : std::true_type {};
+
+  template<typename Key, typename Value = void>
+  struct RedBlackMapNode : RedBlackMapped<Value>
+  {
+    // Key node is ordered by.
+    Key value;
     NodeColor color;
-    RedBlackNode *left;
-    RedBlackNode *right;
-    RedBlackNode *parent;
+    RedBlackMapNode *left;
+    RedBlackMapNode *right;
+    RedBlackMapNode *parent;
+    // Count of nodes in subtree rooted at this node,
+    // kept only by trees with order statistics enabled.
+    int32_t size;
 
-    using node_t = RedBlackNode;
+    using node_t = RedBlackMapNode;
 
-    RedBlackNode(int32_t value)
-      :value{value}, color{NodeColor::red}, left{nullptr},
-       right{nullptr}, parent{nullptr} {}
+    RedBlackMapNode(const Key &value)
+      :RedBlackMapped<Value>{}, value{value}, color{NodeColor::red},
+       left{nullptr}, right{nullptr}, parent{nullptr}, size{1} {}
 
-    RedBlackNode(int32_t value, NodeColor color)
-      :value{value}, color{color}, left{nullptr}, right{nullptr},
-       parent{nullptr}{}
+    RedBlackMapNode(const Key &value, NodeColor color)
+      :RedBlackMapped<Value>{}, value{value}, color{color}, left{nullptr},
+       right{nullptr}, parent{nullptr}, size{1} {}
 
-    RedBlackNode(int32_t value, NodeColor color, node_t *left,
-                 node_t * right, node_t *parent)
-      :value{value}, color{color}, left{left}, right{right},
-       parent{parent}{}
+    RedBlackMapNode(const Key &value, NodeColor color, node_t *left,
+                    node_t * right, node_t *parent)
+      :RedBlackMapped<Value>{}, value{value}, color{color}, left{left},
+       right{right}, parent{parent}, size{1} {}
 
     inline void info() const noexcept
     {
@@ -45,62 +74,374 @@ namespace sdizo{
 
   };
 
-  class RedBlackTree
+  // Ordered map from Key to Value, or ordered set of Key for
+  // Value = void. Equal keys are kept as separate elements.
+  // If Compare is transparent (e.g. std::less<>), lookups accept
+  // any type comparable with Key without converting it first.
+  template<typename Key, typename Value = void,
+           typename Compare = std::less<Key>>
+  class RedBlackMap
   {
     public:
-      static constexpr int32_t GUARD_VALUE =
-        std::numeric_limits<int32_t>::min();
+      using node_t = RedBlackMapNode<Key, Value>;
+      class iterator;
 
     private:
-      RedBlackNode *null_node;
-      RedBlackNode *root;
+      // Type lookup argument of type K is compared as.
+      template<typename K, typename C = Compare, typename = void>
+      struct lookup_type
+      {using type = Key;};
+
+      template<typename K, typename C>
+      struct lookup_type<K, C, std::void_t<typename C::is_transparent>>
+      {using type = K;};
+
+      template<typename K>
+      using lookup_t = typename lookup_type<K>::type;
+
+      node_t *null_node;
+      node_t *root;
+      // Nodes with minimum and maximum value, nullptr if not known.
+      // Inserts past them are attached without search. Reset by
+      // operations other than insert and remove.
+      node_t *leftmost;
+      node_t *rightmost;
+      bool order_statistics;
+      Compare compare;
+      // Filter of keys in tree, nullptr if not enabled.
+      BlockedBloomFilter *filter;
+      double filter_rate;
+      // Count of removes since filter was built.
+      size_t filter_removed;
 
     public:
-      inline RedBlackTree() noexcept
-      :null_node{new RedBlackNode(GUARD_VALUE, NodeColor::black)},
-       root{this->null_node} {}
+      // With order_statistics enabled every node keeps size of its
+      // subtree, which allows rank and select in O(log n).
+      inline explicit RedBlackMap(bool order_statistics = false) noexcept
+      :null_node{new node_t(Key{}, NodeColor::black)},
+       root{this->null_node}, leftmost{nullptr}, rightmost{nullptr},
+       order_statistics{order_statistics},
+       compare{}, filter{nullptr}, filter_rate{0.0}, filter_removed{0}
+      {this->null_node->size = 0;}
 
-      inline ~RedBlackTree() noexcept
-      {this->free(this->root);delete this->null_node;}
+      inline ~RedBlackMap() noexcept
+      {
+        this->free(this->root);
+        delete this->null_node;
+        delete this->filter;
+      }
 
       int32_t loadFromFile(const char *filename) noexcept;
-      void insert(int32_t element) noexcept;
-      void remove(int32_t value);
-      void generate(int32_t rand_range_begin, int32_t rand_range_end,
+      node_t* insert(const Key &element) noexcept;
+      // Inserts element right before hint if it belongs there, which
+      // takes amortized O(1) besides fix up. Otherwise hint is ignored.
+      node_t* insert(iterator hint, const Key &element) noexcept;
+
+      // Inserts element with mapped value, maps only.
+      template<typename V = Value,
+               typename = std::enable_if_t<!std::is_void_v<V>>>
+      inline node_t* insert(const Key &element, const V &mapped) noexcept
+      {
+        auto node = this->insert(element);
+        node->mapped = mapped;
+        return node;
+      }
+
+      template<typename K>
+      void remove(const K &element);
+      void generate(Key rand_range_begin, Key rand_range_end,
                     int32_t size) noexcept;
+
+      // Replaces content of tree with elements of sorted range
+      // [begin, end). Builds balanced tree in O(n) without rotations.
+      void bulk_load(const Key *begin, const Key *end) noexcept;
+
+      // Inserts elements of sorted range [begin, end) by splitting tree
+      // around batch elements and joining the parts back.
+      void bulk_insert(const Key *begin, const Key *end) noexcept;
+
+      // Moves elements not lower than key to right, which is cleared
+      // first.
+      void split(const Key &key, RedBlackMap &right) noexcept;
+      // Moves all elements of right to this tree, none of them can be
+      // lower than elements of this tree. Leaves right empty.
+      void join(RedBlackMap &right) noexcept;
+      // Split and join of nodes take O(log n), but every tree has its
+      // own guard node, so links of the part with lower black height
+      // are moved to the other guard in time linear in its size. Part
+      // going to tree keeping sizes from one that does not is always
+      // walked. Guard is not shared, since removes write its parent.
+
+      // Set operations, equal keys are treated as single element.
+      // Nodes of other are reused or freed, other is left empty.
+      // With parallel set, independent subtrees are processed
+      // by separate threads.
+      void set_union(RedBlackMap &other, bool parallel = false);
+      void set_intersection(RedBlackMap &other, bool parallel = false);
+      // Removes elements present in other.
+      void set_difference(RedBlackMap &other, bool parallel = false);
       // Removes all elements
       inline void clear() noexcept
-      {this->free(this->root); this->root = this->null_node;}
-      RedBlackNode* search(int32_t element) const noexcept;
-      bool contains(int32_t element) const noexcept;
+      {
+        this->free(this->root);
+        this->root = this->null_node;
+        this->leftmost = nullptr;
+        this->rightmost = nullptr;
 
-      // Returns nullptr if no valid node were found.
+        if(this->filter != nullptr)
+          this->filter->clear();
+        this->filter_removed = 0;
+      }
+
+      // Returns guard node if element is not in tree.
+      template<typename K>
+      node_t* search(const K &element) const noexcept;
+      template<typename K>
+      bool contains(const K &element) const noexcept;
+
+      // Returns pointer to value mapped to element or nullptr
+      // if element is not in map, maps only.
+      template<typename K, typename V = Value,
+               typename = std::enable_if_t<!std::is_void_v<V>>>
+      inline V* find(const K &element) const noexcept
+      {
+        auto node = this->search(element);
+        return node != this->null_node ? &node->mapped : nullptr;
+      }
+
+      // Order statistics, throw std::logic_error if not enabled.
+      // Count of elements lower than element.
+      template<typename K>
+      int32_t rank(const K &element) const;
+      // Element at position k in sorted order, counting from 0.
+      Key select(int32_t k) const;
+      // Count of elements in range [begin, end).
+      template<typename K>
+      int32_t range_count(const K &begin, const K &end) const;
+
+      inline bool has_order_statistics() const noexcept
+      {return this->order_statistics;}
+
+      // Keeps Bloom filter of keys in front of lookups, so most lookups
+      // of absent keys end without walking the tree. Filter grows with
+      // tree and is rebuilt after many removes. Bulk insert, split,
+      // join and union rebuild it in O(n). Key needs std::hash.
+      void enable_filter(double false_positive_rate = 0.01);
+      void disable_filter() noexcept;
+
+      // Returns nullptr if filter is not enabled.
+      inline const BlockedBloomFilter* get_filter() const noexcept
+      {return this->filter;}
+
+      // Returns guard node if no valid node were found.
       // Otherwise valid poiter is returned.
-      RedBlackNode* successor(RedBlackNode *node) noexcept;
-      RedBlackNode* predecessor(RedBlackNode *node) noexcept;
-      RedBlackNode* min(RedBlackNode *root) noexcept;
-      RedBlackNode* max(RedBlackNode *root) noexcept;
+      node_t* successor(node_t *node) const noexcept;
+      node_t* predecessor(node_t *node) const noexcept;
+      node_t* min(node_t *root) const noexcept;
+      node_t* max(node_t *root) const noexcept;
+
+      // Bidirectional iterator over elements in ascending order. Steps
+      // follow parent links, walk over whole range is amortized O(1)
+      // per element.
+      class iterator
+      {
+        private:
+          const RedBlackMap *tree;
+          node_t *node;
+
+        public:
+          using iterator_category = std::bidirectional_iterator_tag;
+          using value_type = Key;
+          using difference_type = std::ptrdiff_t;
+          using pointer = const Key*;
+          using reference = const Key&;
+
+          inline iterator(const RedBlackMap *tree, node_t *node) noexcept
+          :tree{tree}, node{node} {}
+
+          inline reference operator*() const noexcept
+          {return this->node->value;}
+
+          inline pointer operator->() const noexcept
+          {return &this->node->value;}
+
+          // Node of element, gives access to mapped value.
+          inline node_t* get_node() const noexcept
+          {return this->node;}
+
+          inline iterator& operator++() noexcept
+          {
+            this->node = this->tree->successor(this->node);
+            return *this;
+          }
+
+          inline iterator operator++(int) noexcept
+          {auto copy = *this; ++*this; return copy;}
 
-      void rot_left(RedBlackNode *node) noexcept;
-      void rot_right(RedBlackNode *node) noexcept;
+          // Decrementing end gives last element.
+          inline iterator& operator--() noexcept
+          {
+            if(this->node != this->tree->null_node)
+              this->node = this->tree->predecessor(this->node);
+            else if(this->tree->root != this->tree->null_node)
+              this->node = this->tree->max(this->tree->root);
+
+            return *this;
+          }
+
+          inline iterator operator--(int) noexcept
+          {auto copy = *this; --*this; return copy;}
+
+          inline bool operator==(const iterator &other) const noexcept
+          {return this->node == other.node;}
+
+          inline bool operator!=(const iterator &other) const noexcept
+          {return this->node != other.node;}
+      };
+
+      inline iterator begin() const noexcept
+      {
+        if(this->root == this->null_node)
+          return this->end();
+
+        if(this->leftmost != nullptr)
+          return iterator(this, this->leftmost);
+
+        return iterator(this, this->min(this->root));
+      }
+
+      inline iterator end() const noexcept
+      {return iterator(this, this->null_node);}
+
+      // First element not lower than element.
+      template<typename K>
+      iterator lower_bound(const K &element) const noexcept;
+      // First element greater than element.
+      template<typename K>
+      iterator upper_bound(const K &element) const noexcept;
+
+      // Calls visit(key) for sets or visit(key, mapped) for maps for all
+      // elements in range [begin, end), in ascending order.
+      template<typename K, typename Visitor>
+      void scan(const K &begin, const K &end, Visitor &&visit) const;
+
+      void rot_left(node_t *node) noexcept;
+      void rot_right(node_t *node) noexcept;
       static unsigned log2(unsigned x) noexcept;
 
       void display() const noexcept;
 
       bool verify_values() const noexcept;
       bool verify_connections() const noexcept;
+      // Checks that no red node has red child and that all paths
+      // have the same count of black nodes.
+      bool verify_colors() const noexcept;
 
-      inline RedBlackNode *get_root() const noexcept
+      inline node_t *get_root() const noexcept
       {return this->root;}
 
     private:
       // Recursively free's node and its childs.
-      void free(RedBlackNode *to_delete) noexcept;
-      bool verify_(RedBlackNode *root) const noexcept;
-      bool verify_connections(RedBlackNode *node) const noexcept;
-      void insert_node(RedBlackNode *node) noexcept;
-      void remove_node(RedBlackNode *node);
+      void free(node_t *to_delete) noexcept;
+      bool verify_(node_t *root) const noexcept;
+      bool verify_connections(node_t *node) const noexcept;
+      void insert_node(node_t *node) noexcept;
+      void remove_node(node_t *node);
+
+      void tree_insert(node_t *node) noexcept;
+      // Links node as child of parent that has no such child and
+      // fixes tree up.
+      void attach(node_t *node, node_t *parent, bool left) noexcept;
+
+      // Rotations and insert fix up working on subtree given by root.
+      // Fix up returns true if black height of subtree grew.
+      void rot_left(node_t *node, node_t *&root) noexcept;
+      void rot_right(node_t *node, node_t *&root) noexcept;
+      bool insert_fixup(node_t *node, node_t *&root) noexcept;
+
+      // Adds key of new node to filter, if there is one.
+      void filter_insert(const Key &key) noexcept;
+      // If new filter cannot be allocated, keys are added to old one.
+      void rebuild_filter() noexcept;
+
+      static constexpr size_t min_filter_capacity = 1024;
 
-      void tree_insert(RedBlackNode *node) noexcept;
+      // Adds delta to sizes of node and all its ancestors.
+      void add_size(node_t *node, int32_t delta) noexcept;
+      void update_size(node_t *node) noexcept;
+
+      // Builds balanced subtree from sorted range, nodes at red_depth
+      // (only deepest, incomplete level) are red.
+      node_t* build(const Key *begin, const Key *end,
+                    int32_t depth, int32_t red_depth) noexcept;
+
+      // Count of black nodes on path from node down to guard,
+      // excluding guard.
+      int32_t black_height(node_t *node) const noexcept;
+      int32_t verify_colors(node_t *node) const noexcept;
+
+      // Makes node root of separate tree.
+      node_t* detach(node_t *node) noexcept;
+      // Same, height grows by one if red node is painted black.
+      node_t* detach(node_t *node, int32_t &height) noexcept;
+
+      // Functions below work on separate trees, black heights of trees
+      // are passed along with them and heights of results are returned
+      // through height arguments, so no spine is walked to find them.
+
+      // Joins trees with all left values lower than middle and all
+      // right values not lower than middle. Returns root of result.
+      node_t* join(node_t *left, int32_t left_height, node_t *middle,
+                   node_t *right, int32_t right_height,
+                   int32_t &height) noexcept;
+
+      // Splits tree into values lower than key and the rest.
+      void split(node_t *node, int32_t node_height, const Key &key,
+                 node_t *&left, int32_t &left_height,
+                 node_t *&right, int32_t &right_height) noexcept;
+
+      node_t* unite(node_t *a, int32_t a_height,
+                    node_t *b, int32_t b_height, int32_t &height) noexcept;
+
+      // Like split, but node with value equal to key is neither in left
+      // nor in right, it is returned (or guard node if not found).
+      node_t* split_equal(node_t *node, int32_t node_height, const Key &key,
+                          node_t *&left, int32_t &left_height,
+                          node_t *&right, int32_t &right_height) noexcept;
+      // Detaches maximum of tree, rest is returned in rest.
+      node_t* split_last(node_t *node, int32_t node_height,
+                         node_t *&rest, int32_t &rest_height) noexcept;
+      // Joins trees with all left values lower than right values.
+      node_t* join(node_t *left, int32_t left_height,
+                   node_t *right, int32_t right_height,
+                   int32_t &height) noexcept;
+
+      // Takes nodes of other tree, both trees point to the same guard.
+      // Returns root of other.
+      node_t* adopt(RedBlackMap &other) noexcept;
+      // Replaces links to guard from with guard to, updates sizes.
+      void relink(node_t *node, node_t *from, node_t *to) noexcept;
+
+      // Recursive set operations, fork into new thread while
+      // forks are left.
+      node_t* union_(node_t *a, int32_t a_height, node_t *b, int32_t b_height,
+                     int32_t forks, int32_t &height);
+      node_t* intersection_(node_t *a, int32_t a_height,
+                            node_t *b, int32_t b_height,
+                            int32_t forks, int32_t &height);
+      node_t* difference_(node_t *a, int32_t a_height,
+                          node_t *b, int32_t b_height,
+                          int32_t forks, int32_t &height);
+      int32_t fork_levels(bool parallel) const noexcept;
+
+      // Subtrees with lower black height are not worth new thread.
+      static constexpr int32_t parallel_min_height = 6;
   };
+
+  using RedBlackNode = RedBlackMapNode<int32_t>;
+  using RedBlackTree = RedBlackMap<int32_t>;
+
+  extern template class RedBlackMap<int32_t>;
 }
+
+#include "redblacktree.tcc"
@@ -0,0 +1,1611 @@
+#pragma once
+#include "redblacktree.hpp"
+#include "treeprinter.hpp"
+#include <cassert>
+#include <stdexcept>
+#include <new>
+#include <random>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <future>
+#include <thread>
+#include <fmt/format.h>
+
+template<typename Key, typename Value, typename Compare>
+int32_t sdizo::RedBlackMap<Key, Value, Compare>::loadFromFile
+(const char *filename) noexcept
+{
+  std::ifstream file(filename);
+  Key num;
+  int32_t count;
+
+  file >> count;
+
+  std::vector<Key> values;
+  values.reserve(std::max(count, 0));
+
+  while(file >> num && count)
+  {
+    values.push_back(num);
+    --count;
+  }
+
+  std::sort(values.begin(), values.end(), this->compare);
+  this->bulk_insert(values.data(), values.data() + values.size());
+
+  return 0;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::insert(const Key &element) noexcept
+{
+  node_t *new_node = new node_t(element);
+  new_node->right = this->null_node;
+  new_node->left = this->null_node;
+
+  if(this->root == this->null_node)
+  {
+    this->insert_node(new_node);
+    this->leftmost = new_node;
+    this->rightmost = new_node;
+    this->filter_insert(element);
+    return new_node;
+  }
+
+  if(this->leftmost == nullptr)
+    this->leftmost = this->min(this->root);
+
+  if(this->rightmost == nullptr)
+    this->rightmost = this->max(this->root);
+
+  // Ascending and descending keys are attached without search
+  if(!this->compare(element, this->rightmost->value))
+  {
+    this->attach(new_node, this->rightmost, false);
+    this->rightmost = new_node;
+  }
+  else if(this->compare(element, this->leftmost->value))
+  {
+    this->attach(new_node, this->leftmost, true);
+    this->leftmost = new_node;
+  }
+  else
+    this->insert_node(new_node);
+
+  this->filter_insert(element);
+  return new_node;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::insert
+(iterator hint, const Key &element) noexcept
+{
+  auto next = hint.get_node();
+
+  // End hint is the case of ascending insert. Keys equal to next go
+  // right of it, as plain insert puts them
+  if(next == this->null_node || !this->compare(element, next->value))
+    return this->insert(element);
+
+  // Minimum has no predecessor, no need to look for it
+  auto previous = this->null_node;
+  if(next != this->leftmost)
+  {
+    previous = this->predecessor(next);
+    if(previous != this->null_node &&
+       this->compare(element, previous->value))
+      return this->insert(element);
+  }
+
+  node_t *new_node = new node_t(element);
+  new_node->right = this->null_node;
+  new_node->left = this->null_node;
+
+  // Either next has no left child, or previous is maximum of that
+  // subtree and has no right child
+  if(next->left == this->null_node)
+  {
+    this->attach(new_node, next, true);
+    if(next == this->leftmost)
+      this->leftmost = new_node;
+  }
+  else
+    this->attach(new_node, previous, false);
+
+  this->filter_insert(element);
+  return new_node;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::attach
+(node_t *node, node_t *parent, bool left) noexcept
+{
+  node->parent = parent;
+  if(left)
+    parent->left = node;
+  else
+    parent->right = node;
+
+  this->add_size(parent, 1);
+  this->insert_fixup(node, this->root);
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::tree_insert(node_t *node)
+noexcept
+{
+  node_t *current_parent = this->null_node;
+  node_t *current_node = this->root;
+  while(current_node != this->null_node)
+  {
+    current_parent = current_node;
+
+    if(this->order_statistics)
+      ++current_node->size;
+
+    if(this->compare(node->value, current_node->value))
+      current_node = current_node->left;
+    else
+      current_node = current_node->right;
+  }
+
+  node->parent = current_parent;
+  if(current_parent == this->null_node)
+    this->root = node;
+  else if(this->compare(node->value, current_parent->value))
+    current_parent->left = node;
+  else
+    current_parent->right = node;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::insert_node(node_t *node)
+noexcept
+{
+  this->tree_insert(node);
+  this->insert_fixup(node, this->root);
+}
+
+template<typename Key, typename Value, typename Compare>
+bool sdizo::RedBlackMap<Key, Value, Compare>::insert_fixup
+(node_t *node, node_t *&root) noexcept
+{
+  node_t *uncle;
+  // redblacktree structure fix
+  while((node != root) && (node->parent->color == NodeColor::red))
+  {
+    bool is_parent_left_child = 
+      node->parent == node->parent->parent->left;
+
+    uncle = is_parent_left_child ? node->parent->parent->right 
+                                 : node->parent->parent->left;
+
+    if(uncle->color == NodeColor::red)
+    {
+      node->parent->color = NodeColor::black;
+      uncle->color = NodeColor::black;
+      node->parent->parent->color = NodeColor::red;
+      node = node->parent->parent;
+      continue;
+    }
+
+    if(is_parent_left_child)
+    {
+      if(node == node->parent->right)
+      {
+        node = node->parent;
+        rot_left(node, root);
+      }
+
+      node->parent->color = NodeColor::black;
+      node->parent->parent->color = NodeColor::red;
+      rot_right(node->parent->parent, root);
+      break;
+    }
+    else
+    {
+      if(node == node->parent->left)
+      {
+        node = node->parent;
+        rot_right(node, root);
+      }
+
+      node->parent->color = NodeColor::black;
+      node->parent->parent->color = NodeColor::red;
+      rot_left(node->parent->parent, root);
+      break;
+    }
+  }
+
+  // Root is red only if recoloring reached it
+  bool grew = root->color == NodeColor::red;
+  root->color = NodeColor::black;
+  return grew;
+}
+
+template<typename Key, typename Value, typename Compare>
+template<typename K>
+void sdizo::RedBlackMap<Key, Value, Compare>::remove(const K &element)
+{
+  auto el = this->search(element);
+  if(el == this->null_node)
+    return;
+
+  this->remove_node(el);
+
+  // Removed keys still pass filter, rebuild once they are many
+  if(this->filter != nullptr &&
+     ++this->filter_removed > this->filter->get_count() / 2)
+    this->rebuild_filter();
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::remove_node(node_t *node)
+{
+  node_t *to_delete;
+  node_t *to_delete_child;
+  node_t *uncle;
+
+  if ((node->left == this->null_node) || (node->right == this->null_node))
+    to_delete = node;
+  else
+    to_delete = this->successor(node);
+
+  // Value of successor moves to node, so node could become new maximum
+  if(to_delete == this->leftmost)
+    this->leftmost = nullptr;
+
+  if(to_delete == this->rightmost)
+    this->rightmost = nullptr;
+
+  if (to_delete->left != this->null_node)
+    to_delete_child = to_delete->left;
+  else
+    to_delete_child = to_delete->right;
+
+  to_delete_child->parent = to_delete->parent;
+
+  if (to_delete->parent == this->null_node)
+    root = to_delete_child;
+  else if (to_delete == to_delete->parent->left)
+    to_delete->parent->left = to_delete_child;
+  else
+    to_delete->parent->right = to_delete_child;
+
+  if (to_delete != node)
+  {
+    node->value = to_delete->value;
+    if constexpr(!std::is_void_v<Value>)
+      node->mapped = std::move(to_delete->mapped);
+  }
+
+  this->add_size(to_delete->parent, -1);
+
+  // If removing black node, tree's black height needs to be fixed
+  if (to_delete->color == NodeColor::black)
+  {
+    while((to_delete_child != root) &&
+          (to_delete_child->color == NodeColor::black))
+    {
+      if (to_delete_child == to_delete_child->parent->left)
+      {
+        uncle = to_delete_child->parent->right;
+
+        if (uncle->color == NodeColor::red)
+        {
+          uncle->color = NodeColor::black;
+          to_delete_child->parent->color = NodeColor::red;
+          rot_left(to_delete_child->parent);
+          uncle = to_delete_child->parent->right;
+        }
+
+        if ((uncle->left->color == NodeColor::black) &&
+            (uncle->right->color == NodeColor::black))
+        {
+          uncle->color = NodeColor::red;
+          to_delete_child = to_delete_child->parent;
+          continue;
+        }
+
+        if (uncle->right->color == NodeColor::black)
+        {
+          uncle->left->color = NodeColor::black;
+          uncle->color = NodeColor::red;
+          rot_right(uncle);
+          uncle = to_delete_child->parent->right;
+        }
+
+        uncle->color = to_delete_child->parent->color;
+        to_delete_child->parent->color = NodeColor::black;
+        uncle->right->color = NodeColor::black;
+        rot_left(to_delete_child->parent);
+        to_delete_child = root;
+      }
+      else
+      {
+        uncle = to_delete_child->parent->left;
+
+        if (uncle->color == NodeColor::red)
+        {
+          uncle->color = NodeColor::black;
+          to_delete_child->parent->color = NodeColor::red;
+          rot_right(to_delete_child->parent);
+          uncle = to_delete_child->parent->left;
+        }
+
+        if ((uncle->left->color == NodeColor::black) &&
+            (uncle->right->color == NodeColor::black))
+        {
+          uncle->color = NodeColor::red;
+          to_delete_child = to_delete_child->parent;
+          continue;
+        }
+
+        if (uncle->left->color == NodeColor::black)
+        {
+          uncle->right->color = NodeColor::black;
+          uncle->color = NodeColor::red;
+          rot_left(uncle);
+          uncle = to_delete_child->parent->left;
+        }
+
+        uncle->color = to_delete_child->parent->color;
+        to_delete_child->parent->color = NodeColor::black;
+        uncle->left->color = NodeColor::black;
+        rot_right(to_delete_child->parent);
+        to_delete_child = root;
+      }
+    }
+  }
+
+  to_delete_child->color = NodeColor::black;
+  delete to_delete;
+}
+
+template<typename Key, typename Value, typename Compare>
+template<typename K>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::search(const K &element) const noexcept
+{
+  // Converts element to Key once, unless Compare is transparent
+  const lookup_t<K> &key = element;
+
+  if constexpr(is_std_hashable<Key>::value &&
+               std::is_same_v<lookup_t<K>, Key>)
+  {
+    if(this->filter != nullptr &&
+       !this->filter->may_contain(sdizo::mix_hash(
+         std::hash<Key>{}(key))))
+      return this->null_node;
+  }
+
+  node_t *current = this->root;
+  while(current != this->null_node)
+  {
+    if(this->compare(current->value, key))
+      current = current->right;
+    else if(this->compare(key, current->value))
+      current = current->left;
+    else
+      break;
+  }
+
+  return current;
+}
+
+template<typename Key, typename Value, typename Compare>
+template<typename K>
+bool sdizo::RedBlackMap<Key, Value, Compare>::contains(const K &element)
+const noexcept
+{
+  return this->search(element) != this->null_node;
+}
+
+template<typename Key, typename Value, typename Compare>
+template<typename K>
+typename sdizo::RedBlackMap<Key, Value, Compare>::iterator
+sdizo::RedBlackMap<Key, Value, Compare>::lower_bound(const K &element)
+const noexcept
+{
+  const lookup_t<K> &key = element;
+
+  node_t *bound = this->null_node;
+  node_t *current = this->root;
+  while(current != this->null_node)
+  {
+    if(this->compare(current->value, key))
+      current = current->right;
+    else
+    {
+      bound = current;
+      current = current->left;
+    }
+  }
+
+  return iterator(this, bound);
+}
+
+template<typename Key, typename Value, typename Compare>
+template<typename K>
+typename sdizo::RedBlackMap<Key, Value, Compare>::iterator
+sdizo::RedBlackMap<Key, Value, Compare>::upper_bound(const K &element)
+const noexcept
+{
+  const lookup_t<K> &key = element;
+
+  node_t *bound = this->null_node;
+  node_t *current = this->root;
+  while(current != this->null_node)
+  {
+    if(this->compare(key, current->value))
+    {
+      bound = current;
+      current = current->left;
+    }
+    else
+      current = current->right;
+  }
+
+  return iterator(this, bound);
+}
+
+template<typename Key, typename Value, typename Compare>
+template<typename K, typename Visitor>
+void sdizo::RedBlackMap<Key, Value, Compare>::scan
+(const K &begin, const K &end, Visitor &&visit) const
+{
+  const lookup_t<K> &last = end;
+
+  for(auto it = this->lower_bound(begin); it != this->end(); ++it)
+  {
+    if(!this->compare(*it, last))
+      return;
+
+    if constexpr(std::is_void_v<Value>)
+      visit(*it);
+    else
+      visit(*it, it.get_node()->mapped);
+  }
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::successor(node_t *root)
+const noexcept
+{
+  assert(root);
+
+  if(root->right != this->null_node)
+    return min(root->right);
+
+  node_t *current_parent = root->parent;
+
+  while
+  (current_parent != this->null_node &&
+   root == current_parent->right)
+  {
+    root = current_parent;
+    current_parent = root->parent;
+  }
+
+  return current_parent;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::predecessor(node_t *node)
+const noexcept
+{
+  assert(node);
+
+  if(node->left != this->null_node)
+    return max(node->left);
+
+  node_t *current_parent = node->parent;
+
+  while
+  (current_parent != this->null_node &&
+   node == current_parent->left)
+  {
+    node = current_parent;
+    current_parent = node->parent;
+  }
+
+  return current_parent;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::min(node_t *root)
+const noexcept
+{
+  assert(root);
+  while(root->left != this->null_node)
+    root = root->left;
+  return root;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::max(node_t *root)
+const noexcept
+{
+  assert(root);
+  while(root->right != this->null_node)
+    root = root->right;
+  return root;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::rot_left(node_t *node) noexcept
+{
+  this->rot_left(node, this->root);
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::rot_right(node_t *node) noexcept
+{
+  this->rot_right(node, this->root);
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::rot_left
+(node_t *node, node_t *&root) noexcept
+{
+  node_t *B = node->right;
+  node_t *p = node->parent;
+
+  if(B != this->null_node)
+  {
+    node->right = B->left;
+    if(node->right != this->null_node) node->right->parent = node;
+
+    B->left = node;
+    B->parent = p;
+    node->parent = B;
+
+    this->update_size(node);
+    this->update_size(B);
+
+    if(p != this->null_node)
+    {
+      if(p->left == node) p->left = B; else p->right = B;
+    }
+    else root = B;
+  }
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::rot_right
+(node_t *node, node_t *&root) noexcept
+{
+  node_t *B = node->left;
+  node_t *p = node->parent;
+
+  if(B != this->null_node)
+  {
+    node->left = B->right;
+    if(node->left != this->null_node) node->left->parent = node;
+
+    B->right = node;
+    B->parent = p;
+    node->parent = B;
+
+    this->update_size(node);
+    this->update_size(B);
+
+    if(p != this->null_node)
+    {
+      if(p->left == node) p->left = B; else p->right = B;
+    }
+    else root = B;
+  }
+}
+
+template<typename Key, typename Value, typename Compare>
+unsigned sdizo::RedBlackMap<Key, Value, Compare>::log2(unsigned x) noexcept
+{
+  unsigned y = 1;
+
+  while((x >>= 1) > 0) y <<= 1;
+
+  return y;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::display() const noexcept
+{
+  puts("===========================");
+  printTree(this->root, 0);
+  puts("===========================");
+}
+
+template<typename Key, typename Value, typename Compare>
+bool sdizo::RedBlackMap<Key, Value, Compare>::verify_values() const noexcept
+{
+  return this->verify_(this->root);
+}
+
+template<typename Key, typename Value, typename Compare>
+bool sdizo::RedBlackMap<Key, Value, Compare>::verify_(node_t *root)
+const noexcept
+{
+  if(root == this->null_node)
+    return true;
+
+  if(!(verify_(root->left) & verify_(root->right)))
+    return false;
+
+  if(root->right != this->null_node &&
+     this->compare(root->right->value, root->value))
+    return false;
+
+  if(root->left != this->null_node &&
+     !this->compare(root->left->value, root->value))
+    return false;
+
+  return true;
+}
+
+template<typename Key, typename Value, typename Compare>
+bool sdizo::RedBlackMap<Key, Value, Compare>::verify_connections()
+const noexcept
+{
+  // Parent of guard node means nothing
+  return this->verify_connections(this->root) &&
+         (this->root == this->null_node ||
+          this->root->parent == this->null_node);
+}
+
+template<typename Key, typename Value, typename Compare>
+bool sdizo::RedBlackMap<Key, Value, Compare>::verify_connections(node_t *node)
+const noexcept
+{
+  if(node == this->null_node)
+    return true;
+
+  if(node->left != this->null_node && node->left->parent != node)
+    return false;
+
+  if(node->right != this->null_node && node->right->parent != node)
+    return false;
+
+  return this->verify_connections(node->left) &&
+         this->verify_connections(node->right);
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::add_size
+(node_t *node, int32_t delta) noexcept
+{
+  if(!this->order_statistics)
+    return;
+
+  for(; node != this->null_node; node = node->parent)
+    node->size += delta;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::update_size(node_t *node)
+noexcept
+{
+  if(this->order_statistics)
+    node->size = node->left->size + node->right->size + 1;
+}
+
+template<typename Key, typename Value, typename Compare>
+template<typename K>
+int32_t sdizo::RedBlackMap<Key, Value, Compare>::rank(const K &element) const
+{
+  if(!this->order_statistics)
+    throw std::logic_error("Order statistics are not enabled for this tree.");
+
+  const lookup_t<K> &key = element;
+
+  int32_t lower = 0;
+  auto current = this->root;
+  while(current != this->null_node)
+  {
+    if(this->compare(current->value, key))
+    {
+      lower += current->left->size + 1;
+      current = current->right;
+    }
+    else
+      current = current->left;
+  }
+
+  return lower;
+}
+
+template<typename Key, typename Value, typename Compare>
+Key sdizo::RedBlackMap<Key, Value, Compare>::select(int32_t k) const
+{
+  if(!this->order_statistics)
+    throw std::logic_error("Order statistics are not enabled for this tree.");
+
+  if(k < 0 || k >= this->root->size)
+    throw std::out_of_range(fmt::format("Cannot select element {}, "
+      "tree holds {} elements.", k, this->root->size));
+
+  auto current = this->root;
+  while(k != current->left->size)
+  {
+    if(k < current->left->size)
+      current = current->left;
+    else
+    {
+      k -= current->left->size + 1;
+      current = current->right;
+    }
+  }
+
+  return current->value;
+}
+
+template<typename Key, typename Value, typename Compare>
+template<typename K>
+int32_t sdizo::RedBlackMap<Key, Value, Compare>::range_count
+(const K &begin, const K &end) const
+{
+  auto count = this->rank(end) - this->rank(begin);
+  return count > 0 ? count : 0;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::enable_filter
+(double false_positive_rate)
+{
+  static_assert(is_std_hashable<Key>::value,
+                "Filter needs std::hash of Key.");
+
+  // Throws before anything changes if rate is wrong
+  auto filter = new BlockedBloomFilter(min_filter_capacity,
+                                       false_positive_rate);
+  delete this->filter;
+  this->filter = filter;
+  this->filter_rate = false_positive_rate;
+  this->rebuild_filter();
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::disable_filter() noexcept
+{
+  delete this->filter;
+  this->filter = nullptr;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::filter_insert(const Key &key)
+noexcept
+{
+  if constexpr(is_std_hashable<Key>::value)
+  {
+    if(this->filter == nullptr)
+      return;
+
+    // Full filter would pass more than expected, key is in tree already
+    if(this->filter->get_count() >= this->filter->get_capacity())
+      this->rebuild_filter();
+    else
+      this->filter->insert(sdizo::mix_hash(std::hash<Key>{}(key)));
+  }
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::rebuild_filter() noexcept
+{
+  if constexpr(is_std_hashable<Key>::value)
+  {
+    if(this->filter == nullptr)
+      return;
+
+    // Root keeps count of nodes only with order statistics
+    size_t count = 0;
+    if(this->order_statistics)
+      count = this->root->size;
+    else
+      for(auto it = this->begin(); it != this->end(); ++it)
+        ++count;
+
+    // Room for as many more elements before it has to grow
+    BlockedBloomFilter *filter;
+    try{
+      filter = new BlockedBloomFilter(
+        std::max(2 * count, min_filter_capacity), this->filter_rate);
+    }catch(std::bad_alloc&){
+      // Old filter is refilled instead, if it is too small it only
+      // passes more absent keys than it should
+      filter = this->filter;
+      filter->clear();
+    }
+
+    for(auto &key : *this)
+      filter->insert(sdizo::mix_hash(std::hash<Key>{}(key)));
+
+    if(filter != this->filter)
+    {
+      delete this->filter;
+      this->filter = filter;
+    }
+
+    this->filter_removed = 0;
+  }
+}
+
+template<typename Key, typename Value, typename Compare>
+bool sdizo::RedBlackMap<Key, Value, Compare>::verify_colors()
+const noexcept
+{
+  return this->root->color == NodeColor::black &&
+         this->verify_colors(this->root) >= 0;
+}
+
+template<typename Key, typename Value, typename Compare>
+int32_t sdizo::RedBlackMap<Key, Value, Compare>::verify_colors(node_t *node)
+const noexcept
+{
+  // Returns black height of subtree, or -1 if subtree is invalid
+  if(node == this->null_node)
+    return 0;
+
+  if(node->color == NodeColor::red &&
+     (node->left->color == NodeColor::red ||
+      node->right->color == NodeColor::red))
+    return -1;
+
+  auto left_height = this->verify_colors(node->left);
+  auto right_height = this->verify_colors(node->right);
+
+  if(left_height < 0 || left_height != right_height)
+    return -1;
+
+  return left_height + (node->color == NodeColor::black);
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::free(node_t *to_delete)
+noexcept
+{
+  if(to_delete == this->null_node)
+    return;
+
+  this->free(to_delete->left);
+  this->free(to_delete->right);
+  delete to_delete;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::generate
+(Key rand_range_begin, Key rand_range_end, int32_t size) noexcept
+{
+  std::random_device generator;
+  std::uniform_int_distribution<Key>
+   distribution(rand_range_begin, rand_range_end);
+
+  std::vector<Key> values(std::max(size, 0));
+  for(auto &value : values)
+    value = distribution(generator);
+
+  std::sort(values.begin(), values.end(), this->compare);
+  this->bulk_load(values.data(), values.data() + values.size());
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::bulk_load
+(const Key *begin, const Key *end) noexcept
+{
+  this->clear();
+
+  // Root would be guard node, which is never written
+  if(begin >= end)
+    return;
+
+  // Levels above red_depth are complete, so making them black
+  // and deepest level red gives equal black height on all paths.
+  int32_t red_depth = 0;
+  while((int64_t{1} << (red_depth + 1)) - 1 <= end - begin)
+    ++red_depth;
+
+  this->root = this->build(begin, end, 0, red_depth);
+  this->root->parent = this->null_node;
+  this->root->color = NodeColor::black;
+  this->rebuild_filter();
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::build
+(const Key *begin, const Key *end, int32_t depth, int32_t red_depth)
+noexcept
+{
+  if(begin >= end)
+    return this->null_node;
+
+  auto middle = begin + (end - begin) / 2;
+  auto color = depth == red_depth ? NodeColor::red : NodeColor::black;
+  auto node = new node_t(*middle, color);
+
+  node->left = this->build(begin, middle, depth + 1, red_depth);
+  node->right = this->build(middle + 1, end, depth + 1, red_depth);
+
+  if(node->left != this->null_node)
+    node->left->parent = node;
+
+  if(node->right != this->null_node)
+    node->right->parent = node;
+
+  this->update_size(node);
+  return node;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::bulk_insert
+(const Key *begin, const Key *end) noexcept
+{
+  if(begin >= end)
+    return;
+
+  this->leftmost = nullptr;
+  this->rightmost = nullptr;
+
+  int32_t red_depth = 0;
+  while((int64_t{1} << (red_depth + 1)) - 1 <= end - begin)
+    ++red_depth;
+
+  auto batch = this->detach(this->build(begin, end, 0, red_depth));
+  auto root = this->detach(this->root);
+
+  int32_t height;
+  this->root = this->unite(root, this->black_height(root),
+                           batch, this->black_height(batch), height);
+  this->rebuild_filter();
+}
+
+template<typename Key, typename Value, typename Compare>
+int32_t sdizo::RedBlackMap<Key, Value, Compare>::black_height(node_t *node)
+const noexcept
+{
+  int32_t height = 0;
+  for(; node != this->null_node; node = node->left)
+    height += node->color == NodeColor::black;
+
+  return height;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::detach(node_t *node)
+noexcept
+{
+  // Guard node is shared by all subtrees, it is never written
+  if(node != this->null_node)
+  {
+    node->parent = this->null_node;
+    node->color = NodeColor::black;
+  }
+
+  return node;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::detach(node_t *node, int32_t &height)
+noexcept
+{
+  if(node != this->null_node && node->color == NodeColor::red)
+    ++height;
+
+  return this->detach(node);
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::join
+(node_t *left, int32_t left_height, node_t *middle,
+ node_t *right, int32_t right_height, int32_t &height) noexcept
+{
+  middle->color = NodeColor::red;
+
+  if(left_height == right_height)
+  {
+    middle->left = left;
+    middle->right = right;
+
+    if(left != this->null_node)
+      left->parent = middle;
+
+    if(right != this->null_node)
+      right->parent = middle;
+
+    this->update_size(middle);
+    height = left_height + 1;
+    return this->detach(middle);
+  }
+
+  // Walk down spine of higher tree to black node of the same black
+  // height as lower tree, middle takes its place as red node.
+  bool left_higher = left_height > right_height;
+  auto root = left_higher ? left : right;
+  auto lower = left_higher ? right : left;
+  auto lower_height = std::min(left_height, right_height);
+  height = std::max(left_height, right_height);
+
+  auto current_height = height;
+  auto parent = this->null_node;
+  auto current = root;
+  while(current->color == NodeColor::red || current_height != lower_height)
+  {
+    current_height -= current->color == NodeColor::black;
+    parent = current;
+    current = left_higher ? current->right : current->left;
+  }
+
+  middle->left = left_higher ? current : lower;
+  middle->right = left_higher ? lower : current;
+  middle->parent = parent;
+
+  if(middle->left != this->null_node)
+    middle->left->parent = middle;
+
+  if(middle->right != this->null_node)
+    middle->right->parent = middle;
+
+  if(left_higher)
+    parent->right = middle;
+  else
+    parent->left = middle;
+
+  this->update_size(middle);
+  this->add_size(parent, lower->size + 1);
+
+  if(this->insert_fixup(middle, root))
+    ++height;
+
+  return root;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::split
+(node_t *node, int32_t node_height, const Key &key,
+ node_t *&left, int32_t &left_height,
+ node_t *&right, int32_t &right_height) noexcept
+{
+  if(node == this->null_node)
+  {
+    left = right = this->null_node;
+    left_height = right_height = 0;
+    return;
+  }
+
+  // Root of separate tree is black
+  auto node_left_height = node_height - 1;
+  auto node_right_height = node_height - 1;
+  auto node_left = this->detach(node->left, node_left_height);
+  auto node_right = this->detach(node->right, node_right_height);
+
+  node_t *middle;
+  int32_t middle_height;
+  if(!this->compare(node->value, key))
+  {
+    this->split(node_left, node_left_height, key,
+                left, left_height, middle, middle_height);
+    right = this->join(middle, middle_height, node,
+                       node_right, node_right_height, right_height);
+  }
+  else
+  {
+    this->split(node_right, node_right_height, key,
+                middle, middle_height, right, right_height);
+    left = this->join(node_left, node_left_height, node,
+                      middle, middle_height, left_height);
+  }
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::unite
+(node_t *a, int32_t a_height, node_t *b, int32_t b_height, int32_t &height)
+noexcept
+{
+  if(b == this->null_node)
+  {
+    height = a_height;
+    return a;
+  }
+
+  if(a == this->null_node)
+  {
+    height = b_height;
+    return b;
+  }
+
+  auto b_left_height = b_height - 1;
+  auto b_right_height = b_height - 1;
+  auto b_left = this->detach(b->left, b_left_height);
+  auto b_right = this->detach(b->right, b_right_height);
+
+  node_t *left;
+  node_t *right;
+  int32_t left_height;
+  int32_t right_height;
+  this->split(a, a_height, b->value, left, left_height, right, right_height);
+
+  left = this->unite(left, left_height, b_left, b_left_height, left_height);
+  right = this->unite(right, right_height, b_right, b_right_height,
+                      right_height);
+
+  return this->join(left, left_height, b, right, right_height, height);
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::split_equal
+(node_t *node, int32_t node_height, const Key &key,
+ node_t *&left, int32_t &left_height,
+ node_t *&right, int32_t &right_height) noexcept
+{
+  if(node == this->null_node)
+  {
+    left = right = this->null_node;
+    left_height = right_height = 0;
+    return this->null_node;
+  }
+
+  auto node_left_height = node_height - 1;
+  auto node_right_height = node_height - 1;
+  auto node_left = this->detach(node->left, node_left_height);
+  auto node_right = this->detach(node->right, node_right_height);
+
+  node_t *middle;
+  int32_t middle_height;
+  node_t *equal;
+  if(this->compare(key, node->value))
+  {
+    equal = this->split_equal(node_left, node_left_height, key,
+                              left, left_height, middle, middle_height);
+    right = this->join(middle, middle_height, node,
+                       node_right, node_right_height, right_height);
+  }
+  else if(this->compare(node->value, key))
+  {
+    equal = this->split_equal(node_right, node_right_height, key,
+                              middle, middle_height, right, right_height);
+    left = this->join(node_left, node_left_height, node,
+                      middle, middle_height, left_height);
+  }
+  else
+  {
+    left = node_left;
+    left_height = node_left_height;
+    right = node_right;
+    right_height = node_right_height;
+    equal = node;
+  }
+
+  return equal;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::split_last
+(node_t *node, int32_t node_height, node_t *&rest, int32_t &rest_height)
+noexcept
+{
+  auto node_left_height = node_height - 1;
+  auto node_right_height = node_height - 1;
+  auto node_left = this->detach(node->left, node_left_height);
+  auto node_right = this->detach(node->right, node_right_height);
+
+  if(node_right == this->null_node)
+  {
+    rest = node_left;
+    rest_height = node_left_height;
+    return node;
+  }
+
+  node_t *right_rest;
+  int32_t right_rest_height;
+  auto last = this->split_last(node_right, node_right_height,
+                               right_rest, right_rest_height);
+  rest = this->join(node_left, node_left_height, node,
+                    right_rest, right_rest_height, rest_height);
+  return last;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::join
+(node_t *left, int32_t left_height, node_t *right, int32_t right_height,
+ int32_t &height) noexcept
+{
+  if(right == this->null_node)
+  {
+    height = left_height;
+    return left;
+  }
+
+  if(left == this->null_node)
+  {
+    height = right_height;
+    return right;
+  }
+
+  node_t *rest;
+  int32_t rest_height;
+  auto last = this->split_last(left, left_height, rest, rest_height);
+  return this->join(rest, rest_height, last, right, right_height, height);
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::relink
+(node_t *node, node_t *from, node_t *to) noexcept
+{
+  if(node == from)
+    return;
+
+  this->relink(node->left, from, to);
+  this->relink(node->right, from, to);
+
+  if(node->left == from)
+    node->left = to;
+
+  if(node->right == from)
+    node->right = to;
+
+  this->update_size(node);
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::adopt(RedBlackMap &other) noexcept
+{
+  auto other_root = other.root;
+  this->leftmost = nullptr;
+  this->rightmost = nullptr;
+  other.leftmost = nullptr;
+  other.rightmost = nullptr;
+
+  // Other is left empty
+  if(other.filter != nullptr)
+    other.filter->clear();
+
+  if(other_root == other.null_node)
+    return this->null_node;
+
+  // Relink guard links of smaller tree, unless other does not keep
+  // sizes, then it must be walked anyway to compute them
+  bool relink_other =
+    other.black_height(other_root) <= this->black_height(this->root) ||
+    (this->order_statistics && !other.order_statistics);
+
+  if(relink_other)
+  {
+    this->relink(other_root, other.null_node, this->null_node);
+  }
+  else
+  {
+    this->relink(this->root, this->null_node, other.null_node);
+    std::swap(this->null_node, other.null_node);
+
+    if(this->root == other.null_node)
+      this->root = this->null_node;
+  }
+
+  other.root = other.null_node;
+  return other_root;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::split
+(const Key &key, RedBlackMap &right) noexcept
+{
+  right.clear();
+  this->leftmost = nullptr;
+  this->rightmost = nullptr;
+
+  node_t *left_root;
+  node_t *right_root;
+  int32_t left_height;
+  int32_t right_height;
+  auto root = this->detach(this->root);
+  this->split(root, this->black_height(root), key,
+              left_root, left_height, right_root, right_height);
+
+  // Both parts link to guard of this tree, smaller one is moved
+  // to guard of right. Right part is walked anyway if right keeps
+  // sizes and this does not, so they are computed by right.
+  auto guard = this->null_node;
+  if(right_height <= left_height ||
+     (right.order_statistics && !this->order_statistics))
+  {
+    right.relink(right_root, this->null_node, right.null_node);
+  }
+  else
+  {
+    this->relink(left_root, this->null_node, right.null_node);
+    std::swap(this->null_node, right.null_node);
+  }
+
+  if(left_root == guard)
+    left_root = this->null_node;
+
+  if(right_root == guard)
+    right_root = right.null_node;
+
+  this->root = left_root;
+  right.root = right_root;
+
+  if(left_root != this->null_node)
+    left_root->parent = this->null_node;
+
+  if(right_root != right.null_node)
+    right_root->parent = right.null_node;
+
+  // Filter of this only keeps extra keys, which is allowed
+  right.rebuild_filter();
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::join(RedBlackMap &right) noexcept
+{
+  auto right_root = this->detach(this->adopt(right));
+  auto left_root = this->detach(this->root);
+
+  int32_t height;
+  this->root = this->join(left_root, this->black_height(left_root),
+                          right_root, this->black_height(right_root), height);
+  this->rebuild_filter();
+}
+
+template<typename Key, typename Value, typename Compare>
+int32_t sdizo::RedBlackMap<Key, Value, Compare>::fork_levels(bool parallel) const noexcept
+{
+  if(!parallel)
+    return 0;
+
+  // Enough levels to give each hardware thread at least two subtrees
+  int32_t levels = 1;
+  for(auto threads = std::thread::hardware_concurrency(); threads > 1;
+      threads >>= 1)
+    ++levels;
+
+  return levels;
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::set_union
+(RedBlackMap &other, bool parallel)
+{
+  auto other_root = this->detach(this->adopt(other));
+  auto root = this->detach(this->root);
+
+  int32_t height;
+  this->root = this->union_(root, this->black_height(root),
+                            other_root, this->black_height(other_root),
+                            this->fork_levels(parallel), height);
+  this->rebuild_filter();
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::set_intersection
+(RedBlackMap &other, bool parallel)
+{
+  auto other_root = this->detach(this->adopt(other));
+  auto root = this->detach(this->root);
+
+  int32_t height;
+  this->root = this->intersection_(root, this->black_height(root),
+                                   other_root, this->black_height(other_root),
+                                   this->fork_levels(parallel), height);
+}
+
+template<typename Key, typename Value, typename Compare>
+void sdizo::RedBlackMap<Key, Value, Compare>::set_difference
+(RedBlackMap &other, bool parallel)
+{
+  auto other_root = this->detach(this->adopt(other));
+  auto root = this->detach(this->root);
+
+  int32_t height;
+  this->root = this->difference_(root, this->black_height(root),
+                                 other_root, this->black_height(other_root),
+                                 this->fork_levels(parallel), height);
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::union_
+(node_t *a, int32_t a_height, node_t *b, int32_t b_height,
+ int32_t forks, int32_t &height)
+{
+  if(b == this->null_node)
+  {
+    height = a_height;
+    return a;
+  }
+
+  if(a == this->null_node)
+  {
+    height = b_height;
+    return b;
+  }
+
+  bool fork = forks > 0 &&
+    std::min(a_height, b_height) >= parallel_min_height;
+
+  auto b_left_height = b_height - 1;
+  auto b_right_height = b_height - 1;
+  auto b_left = this->detach(b->left, b_left_height);
+  auto b_right = this->detach(b->right, b_right_height);
+
+  node_t *a_left;
+  node_t *a_right;
+  int32_t a_left_height;
+  int32_t a_right_height;
+  auto equal = this->split_equal(a, a_height, b->value,
+                                 a_left, a_left_height,
+                                 a_right, a_right_height);
+
+  // Element already in tree is kept
+  auto middle = b;
+  if(equal != this->null_node)
+  {
+    delete b;
+    middle = equal;
+  }
+
+  node_t *left;
+  node_t *right;
+  int32_t left_height;
+  int32_t right_height;
+  if(fork)
+  {
+    auto left_future = std::async(std::launch::async, [=, &left_height]{
+      return this->union_(a_left, a_left_height, b_left, b_left_height,
+                          forks - 1, left_height);
+    });
+    right = this->union_(a_right, a_right_height, b_right, b_right_height,
+                         forks - 1, right_height);
+    left = left_future.get();
+  }
+  else
+  {
+    left = this->union_(a_left, a_left_height, b_left, b_left_height,
+                        forks, left_height);
+    right = this->union_(a_right, a_right_height, b_right, b_right_height,
+                         forks, right_height);
+  }
+
+  return this->join(left, left_height, middle, right, right_height, height);
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::intersection_
+(node_t *a, int32_t a_height, node_t *b, int32_t b_height,
+ int32_t forks, int32_t &height)
+{
+  if(a == this->null_node || b == this->null_node)
+  {
+    this->free(a);
+    this->free(b);
+    height = 0;
+    return this->null_node;
+  }
+
+  bool fork = forks > 0 &&
+    std::min(a_height, b_height) >= parallel_min_height;
+
+  auto b_left_height = b_height - 1;
+  auto b_right_height = b_height - 1;
+  auto b_left = this->detach(b->left, b_left_height);
+  auto b_right = this->detach(b->right, b_right_height);
+
+  node_t *a_left;
+  node_t *a_right;
+  int32_t a_left_height;
+  int32_t a_right_height;
+  auto equal = this->split_equal(a, a_height, b->value,
+                                 a_left, a_left_height,
+                                 a_right, a_right_height);
+  delete b;
+
+  node_t *left;
+  node_t *right;
+  int32_t left_height;
+  int32_t right_height;
+  if(fork)
+  {
+    auto left_future = std::async(std::launch::async, [=, &left_height]{
+      return this->intersection_(a_left, a_left_height, b_left, b_left_height,
+                                 forks - 1, left_height);
+    });
+    right = this->intersection_(a_right, a_right_height,
+                                b_right, b_right_height,
+                                forks - 1, right_height);
+    left = left_future.get();
+  }
+  else
+  {
+    left = this->intersection_(a_left, a_left_height, b_left, b_left_height,
+                               forks, left_height);
+    right = this->intersection_(a_right, a_right_height,
+                                b_right, b_right_height,
+                                forks, right_height);
+  }
+
+  if(equal != this->null_node)
+    return this->join(left, left_height, equal, right, right_height, height);
+
+  return this->join(left, left_height, right, right_height, height);
+}
+
+template<typename Key, typename Value, typename Compare>
+typename sdizo::RedBlackMap<Key, Value, Compare>::node_t*
+sdizo::RedBlackMap<Key, Value, Compare>::difference_
+(node_t *a, int32_t a_height, node_t *b, int32_t b_height,
+ int32_t forks, int32_t &height)
+{
+  if(a == this->null_node)
+  {
+    this->free(b);
+    height = 0;
+    return this->null_node;
+  }
+
+  if(b == this->null_node)
+  {
+    height = a_height;
+    return a;
+  }
+
+  bool fork = forks > 0 &&
+    std::min(a_height, b_height) >= parallel_min_height;
+
+  auto b_left_height = b_height - 1;
+  auto b_right_height = b_height - 1;
+  auto b_left = this->detach(b->left, b_left_height);
+  auto b_right = this->detach(b->right, b_right_height);
+
+  node_t *a_left;
+  node_t *a_right;
+  int32_t a_left_height;
+  int32_t a_right_height;
+  auto equal = this->split_equal(a, a_height, b->value,
+                                 a_left, a_left_height,
+                                 a_right, a_right_height);
+  delete b;
+
+  if(equal != this->null_node)
+    delete equal;
+
+  node_t *left;
+  node_t *right;
+  int32_t left_height;
+  int32_t right_height;
+  if(fork)
+  {
+    auto left_future = std::async(std::launch::async, [=, &left_height]{
+      return this->difference_(a_left, a_left_height, b_left, b_left_height,
+                               forks - 1, left_height);
+    });
+    right = this->difference_(a_right, a_right_height,
+                              b_right, b_right_height,
+                              forks - 1, right_height);
+    left = left_future.get();
+  }
+  else
+  {
+    left = this->difference_(a_left, a_left_height, b_left, b_left_height,
+                             forks, left_height);
+    right = this->difference_(a_right, a_right_height,
+                              b_right, b_right_height,
+                              forks, right_height);
+  }
+
+  return this->join(left, left_height, right, right_height, height);
+}
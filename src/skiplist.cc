@@ -0,0 +1,371 @@
+#include "skiplist.hpp"
+#include <random>
+#include <fstream>
+#include <cstdio>
+#include <limits>
+#include <new>
+
+using sdizo::SkipListNode;
+
+constexpr auto acquire = std::memory_order_acquire;
+
+sdizo::SkipList::SkipList()
+:head{new_node(0, max_height)}, levels{1}, size{0}
+{}
+
+sdizo::SkipList::~SkipList() noexcept
+{
+  // Removed nodes are unlinked already and owned by epochs
+  auto node = to_node(this->head->next(0).load());
+  while(node != nullptr)
+  {
+    auto next = to_node(node->next(0).load());
+    delete_node(node);
+    node = next;
+  }
+
+  delete_node(this->head);
+}
+
+SkipListNode* sdizo::SkipList::new_node(int32_t value, int32_t height)
+{
+  auto memory = ::operator new(sizeof(node_t) +
+                               height * sizeof(node_t::link_t));
+
+  auto node = new(memory) node_t;
+  node->value = value;
+  node->height = height;
+  node->owners.store(2, std::memory_order_relaxed);
+
+  for(int32_t i = 0; i < height; ++i)
+    new(&node->next(i)) node_t::link_t(0);
+
+  return node;
+}
+
+void sdizo::SkipList::delete_node(void *node) noexcept
+{
+  ::operator delete(node);
+}
+
+int32_t sdizo::SkipList::random_height() noexcept
+{
+  // Each level is reached by half of nodes of level below
+  static thread_local std::minstd_rand generator(std::random_device{}());
+  uint32_t bits = generator() | generator() << 16;
+  return 1 + __builtin_ctz(bits | 1u << (max_height - 1));
+}
+
+int32_t sdizo::SkipList::loadFromFile(const char *filename)
+{
+  std::ifstream file(filename);
+  int32_t num;
+  int32_t count;
+
+  file >> count;
+
+  while(file >> num && count)
+  {
+    this->insert(num);
+    --count;
+  }
+
+  return 0;
+}
+
+bool sdizo::SkipList::find(int32_t element, node_t **preds, node_t **succs)
+{
+retry:
+  auto pred = this->head;
+  for(int32_t level = max_height - 1; level >= 0; --level)
+  {
+    auto current = to_node(pred->next(level).load(acquire));
+
+    while(current != nullptr)
+    {
+      auto next = current->next(level).load(acquire);
+
+      // Fails if pred got marked or linked to another node meanwhile
+      if(is_marked(next))
+      {
+        auto expected = reinterpret_cast<uintptr_t>(current);
+        if(!pred->next(level).compare_exchange_strong(expected,
+                                                      next & ~uintptr_t{1}))
+          goto retry;
+
+        current = to_node(next);
+        continue;
+      }
+
+      if(current->value >= element)
+        break;
+
+      pred = current;
+      current = to_node(next);
+    }
+
+    preds[level] = pred;
+    succs[level] = current;
+  }
+
+  return succs[0] != nullptr && succs[0]->value == element;
+}
+
+const SkipListNode* sdizo::SkipList::lower_bound
+(int32_t element) const noexcept
+{
+  const node_t *pred = this->head;
+  const node_t *current = nullptr;
+
+  for(int32_t level = this->levels.load(acquire) - 1; level >= 0; --level)
+  {
+    current = to_node(pred->next(level).load(acquire));
+
+    while(current != nullptr)
+    {
+      auto next = current->next(level).load(acquire);
+      if(!is_marked(next) && current->value >= element)
+        break;
+
+      // Marked nodes are passed over whatever their value is
+      if(!is_marked(next))
+        pred = current;
+
+      current = to_node(next);
+    }
+  }
+
+  return current;
+}
+
+bool sdizo::SkipList::insert(int32_t element)
+{
+  auto guard = this->epochs.pin();
+  node_t *preds[max_height];
+  node_t *succs[max_height];
+  node_t *node = nullptr;
+
+  // Inserted once linked on lowest level
+  while(true)
+  {
+    if(this->find(element, preds, succs))
+    {
+      if(node != nullptr)
+        delete_node(node);
+
+      return false;
+    }
+
+    if(node == nullptr)
+      node = new_node(element, random_height());
+
+    for(int32_t level = 0; level < node->height; ++level)
+      node->next(level).store(reinterpret_cast<uintptr_t>(succs[level]),
+                              std::memory_order_relaxed);
+
+    auto expected = reinterpret_cast<uintptr_t>(succs[0]);
+    if(preds[0]->next(0).compare_exchange_strong(expected,
+         reinterpret_cast<uintptr_t>(node)))
+      break;
+  }
+
+  this->size.fetch_add(1, std::memory_order_relaxed);
+
+  auto levels = this->levels.load(std::memory_order_relaxed);
+  while(levels < node->height &&
+        !this->levels.compare_exchange_weak(levels, node->height));
+
+  // Upper levels only speed up search, linking stops once node is removed
+  for(int32_t level = 1; level < node->height; ++level)
+  {
+    while(true)
+    {
+      auto next = node->next(level).load(acquire);
+      auto succ = reinterpret_cast<uintptr_t>(succs[level]);
+
+      if(is_marked(next))
+        goto linked;
+
+      if(next != succ && !node->next(level).compare_exchange_strong(next, succ))
+        continue;
+
+      auto expected = reinterpret_cast<uintptr_t>(succs[level]);
+      if(preds[level]->next(level).compare_exchange_strong(expected,
+           reinterpret_cast<uintptr_t>(node)))
+        break;
+
+      // Node itself may have been removed and unlinked meanwhile
+      if(!this->find(element, preds, succs) || succs[0] != node)
+        goto linked;
+    }
+  }
+
+linked:
+  this->release(node);
+  return true;
+}
+
+bool sdizo::SkipList::remove(int32_t element)
+{
+  auto guard = this->epochs.pin();
+  node_t *preds[max_height];
+  node_t *succs[max_height];
+
+  if(!this->find(element, preds, succs))
+    return false;
+
+  auto node = succs[0];
+
+  // Marking top down keeps node reachable from above
+  // only while it is still in set
+  for(int32_t level = node->height - 1; level > 0; --level)
+  {
+    auto next = node->next(level).load(acquire);
+    while(!is_marked(next) &&
+          !node->next(level).compare_exchange_weak(next, next | 1));
+  }
+
+  // Thread that marks lowest level is the one that removed element
+  auto next = node->next(0).load(acquire);
+  while(true)
+  {
+    if(is_marked(next))
+      return false;
+
+    if(node->next(0).compare_exchange_weak(next, next | 1))
+      break;
+  }
+
+  this->size.fetch_sub(1, std::memory_order_relaxed);
+  this->release(node);
+  return true;
+}
+
+void sdizo::SkipList::release(node_t *node)
+{
+  if(!is_marked(node->next(0).load(acquire)))
+  {
+    // Inserter lets go of node that is still in set
+    if(node->owners.fetch_sub(1) == 1)
+      this->epochs.retire(node, delete_node);
+    return;
+  }
+
+  // Unlink node from every level before letting go of it. Nodes are
+  // linked only in front of first node not lower than their value, so
+  // walk to element passes through node on every level it is linked on
+  node_t *preds[max_height];
+  node_t *succs[max_height];
+  this->find(node->value, preds, succs);
+
+  if(node->owners.fetch_sub(1) == 1)
+    this->epochs.retire(node, delete_node);
+}
+
+void sdizo::SkipList::generate
+(int32_t rand_range_begin, int32_t rand_range_end, int32_t size)
+{
+  std::random_device generator;
+  std::uniform_int_distribution<int32_t>
+   distribution(rand_range_begin, rand_range_end);
+
+  this->clear();
+  for(int32_t i = 0; i < size; ++i)
+  {
+    this->insert(distribution(generator));
+  }
+}
+
+void sdizo::SkipList::clear()
+{
+  auto node = to_node(this->head->next(0).load());
+  while(node != nullptr)
+  {
+    auto next = to_node(node->next(0).load());
+    delete_node(node);
+    node = next;
+  }
+
+  for(int32_t level = 0; level < max_height; ++level)
+    this->head->next(level).store(0);
+
+  this->levels.store(1);
+  this->size.store(0);
+}
+
+bool sdizo::SkipList::contains(int32_t element) const
+{
+  auto guard = this->epochs.pin();
+  auto node = this->lower_bound(element);
+  return node != nullptr && node->value == element;
+}
+
+bool sdizo::SkipList::successor(int32_t element, int32_t &next) const
+{
+  if(element == std::numeric_limits<int32_t>::max())
+    return false;
+
+  auto guard = this->epochs.pin();
+  auto node = this->lower_bound(element + 1);
+  if(node == nullptr)
+    return false;
+
+  next = node->value;
+  return true;
+}
+
+void sdizo::SkipList::display() const
+{
+  puts("===========================");
+  for(int32_t level = this->levels.load() - 1; level >= 0; --level)
+  {
+    printf("%2i: [", level);
+    bool first = true;
+    for(auto node = to_node(this->head->next(level).load());
+        node != nullptr; node = to_node(node->next(level).load()))
+    {
+      printf(first ? "%i" : " %i", node->value);
+      first = false;
+    }
+    puts("]");
+  }
+  puts("===========================");
+}
+
+bool sdizo::SkipList::verify() const
+{
+  int32_t count = 0;
+
+  for(int32_t level = 0; level < max_height; ++level)
+  {
+    auto below = to_node(this->head->next(level > 0 ? level - 1 : 0).load());
+    const node_t *previous = nullptr;
+
+    for(auto node = to_node(this->head->next(level).load());
+        node != nullptr; node = to_node(node->next(level).load()))
+    {
+      if(is_marked(node->next(level).load()) || node->height <= level)
+        return false;
+
+      if(previous != nullptr && previous->value >= node->value)
+        return false;
+
+      // Level below has to reach same node
+      while(below != nullptr && below != node)
+        below = to_node(below->next(level > 0 ? level - 1 : 0).load());
+
+      if(below == nullptr)
+        return false;
+
+      if(level == 0)
+        ++count;
+
+      previous = node;
+    }
+
+    if(level >= this->levels.load() && previous != nullptr)
+      return false;
+  }
+
+  return count == this->get_size();
+}
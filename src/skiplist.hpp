@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <atomic>
+#include "epoch.hpp"
+
+namespace sdizo{
+  // Tower of skip list. Links to next nodes on each level follow the
+  // node in the same allocation, lowest bit of link marks node as
+  // removed on that level.
+  struct alignas(8) SkipListNode
+  {
+    using link_t = std::atomic<uintptr_t>;
+
+    int32_t value;
+    int32_t height;
+    // Inserting thread and removing thread, the one which
+    // lets go last retires node.
+    std::atomic<int32_t> owners;
+
+    inline link_t& next(int32_t level) noexcept
+    {return reinterpret_cast<link_t*>(this + 1)[level];}
+
+    inline const link_t& next(int32_t level) const noexcept
+    {return reinterpret_cast<const link_t*>(this + 1)[level];}
+  };
+
+  // Ordered set of int32_t safe for any number of concurrent readers
+  // and writers without locks. Element belongs to set once linked on
+  // lowest level, and is removed once its lowest link is marked. Marked
+  // nodes are unlinked by any thread that walks past them, and released
+  // through EpochManager. Inserting element already in set does nothing.
+  class SkipList
+  {
+    public:
+      using node_t = SkipListNode;
+      static constexpr int32_t max_height = 24;
+
+    private:
+      node_t *head;
+      // Highest level any node reached.
+      std::atomic<int32_t> levels;
+      std::atomic<int32_t> size;
+      mutable EpochManager epochs;
+
+    public:
+      SkipList();
+      SkipList(const SkipList&) = delete;
+      // No thread may use list anymore.
+      ~SkipList() noexcept;
+
+      int32_t loadFromFile(const char *filename);
+      // Returns false if element was already in set.
+      bool insert(int32_t element);
+      // Returns false if element was not in set.
+      bool remove(int32_t element);
+      void generate(int32_t rand_range_begin, int32_t rand_range_end,
+                    int32_t size);
+
+      // Removes all elements, no other thread may use list meanwhile.
+      void clear();
+      bool contains(int32_t element) const;
+
+      // Sets next to smallest element greater than element,
+      // returns false if there is no such element.
+      bool successor(int32_t element, int32_t &next) const;
+
+      // Calls visit(element) for elements in range [begin, end) in
+      // ascending order. Elements inserted or removed during scan
+      // may or may not be visited.
+      template<typename Visitor>
+      void scan(int32_t begin, int32_t end, Visitor &&visit) const;
+
+      void display() const;
+
+      // Checks that every level is sorted, upper levels hold only nodes
+      // of lower ones and no removed node is left linked. No other thread
+      // may use list meanwhile.
+      bool verify() const;
+
+      inline int32_t get_size() const noexcept
+      {return this->size.load(std::memory_order_relaxed);}
+
+    private:
+      // Fills preds and succs with nodes around element on every level,
+      // unlinking marked nodes on the way. Returns true if succs[0]
+      // holds element.
+      bool find(int32_t element, node_t **preds, node_t **succs);
+      // Returns first node on lowest level not lower than element,
+      // marked nodes are skipped without unlinking.
+      const node_t* lower_bound(int32_t element) const noexcept;
+      void release(node_t *node);
+
+      static node_t* new_node(int32_t value, int32_t height);
+      static void delete_node(void *node) noexcept;
+      static int32_t random_height() noexcept;
+
+      static inline bool is_marked(uintptr_t link) noexcept
+      {return link & 1;}
+
+      static inline node_t* to_node(uintptr_t link) noexcept
+      {return reinterpret_cast<node_t*>(link & ~uintptr_t{1});}
+  };
+}
+
+template<typename Visitor>
+void sdizo::SkipList::scan(int32_t begin, int32_t end, Visitor &&visit) const
+{
+  if(begin >= end)
+    return;
+
+  auto guard = this->epochs.pin();
+
+  for(auto node = this->lower_bound(begin);
+      node != nullptr && node->value < end;)
+  {
+    auto next = node->next(0).load(std::memory_order_acquire);
+    if(!is_marked(next))
+      visit(node->value);
+
+    node = to_node(next);
+  }
+}
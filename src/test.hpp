@@ -10,15 +10,44 @@ namespace sdizo{
     bool test_list();
     bool test_list2();
     bool test_heap();
+    bool test_lookup_heap();
+    bool test_heap_stats();
+    bool test_dijkstra_queries();
     bool test_bst();
     bool test_bst2();
+    bool test_bst3();
+    bool test_bst_bulk_build();
+    bool test_bst_scapegoat();
+    bool test_bst_snapshot();
+    bool test_bst_splay();
     bool test_rbt();
+    bool test_rbt_bulk();
+    bool test_rbt_order_statistics();
+    bool test_rbt_map();
+    bool test_rbt_set_operations();
+    bool test_rbt_iteration();
+    bool test_rbt_hinted_insert();
+    bool test_rbt_filter();
+    bool test_compact_rbt();
+    bool test_persistent_rbt();
+    bool test_concurrent_rbt();
+    bool test_bplustree();
+    bool test_van_emde_boas();
+    bool test_hash_set();
+    bool test_skiplist();
     bool test_disjoint_set();
+    bool test_flat_disjoint_set();
+    bool test_concurrent_disjoint_set();
     bool run_array_tests();
     bool run_list_tests();
     bool run_heap_tests();
+    bool run_lookup_heap_tests();
     bool run_bst_tests();
     bool run_rbt_tests();
+    bool run_bplustree_tests();
+    bool run_veb_tests();
+    bool run_hash_set_tests();
+    bool run_skiplist_tests();
     bool run_disjoint_set_tests();
 
     bool templatize_test(); // Tests for templated versions of containers
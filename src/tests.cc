@@ -3,13 +3,29 @@
 #include "list.hpp"
 #include "heap.hpp"
 #include "tree.hpp"
+#include "treesnapshot.hpp"
 #include "redblacktree.hpp"
+#include "compactredblacktree.hpp"
+#include "persistentredblacktree.hpp"
+#include "concurrentredblacktree.hpp"
+#include "bplustree.hpp"
+#include "vanemdeboastree.hpp"
+#include "hashset.hpp"
+#include "skiplist.hpp"
 #include "mst.hpp"
+#include "dijkstra.hpp"
 #include <random>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <type_traits>
 #if __cplusplus == 201703L
 #define TESTS_CPP_17 true
 #include <filesystem>
 #include <fstream>
+#include <string_view>
 #endif
 
 #define TEST_INVOKE_ASSERT_TRUE(test_func, ...) if(!test_func(__VA_ARGS__)) return false;
@@ -158,83 +174,1507 @@ bool sdizo::tests::test_heap()
   return heap.verify();
 }
 
+template<sdizo2::dijkstra::HeapLayout layout>
+static bool test_lookup_heap_layout()
+{
+  sdizo2::dijkstra::LookupHeap<layout> heap(8);
+
+  // Nodes are undiscovered before first reset and after clear
+  TEST_ASSERT_EQ(heap.find({5, 0}), -1)
+  heap.update(5, 4);
+  TEST_ASSERT_EQ(heap.find({5, 0}), 0)
+  heap.clear();
+  TEST_ASSERT_EQ(heap.find({5, 0}), -1)
+
+  for(int32_t query = 0; query < 3; ++query)
+  {
+    heap.reset(3);
+    TEST_ASSERT_EQ(heap.get_ssize(), 1)
+    TEST_ASSERT_EQ(heap.find({5, 0}), -1)
+
+    heap.update(5, 10);
+    heap.update(1, 7);
+    heap.update(6, 12);
+    heap.update(5, 2);
+    TEST_ASSERT_EQ(heap.get_ssize(), 4)
+    TEST_INVOKE_ASSERT_TRUE(heap.verify);
+
+    TEST_ASSERT_EQ(heap.pop().node, 3)
+    TEST_ASSERT_EQ(heap.pop().node, 5)
+    TEST_ASSERT_EQ(heap.find({5, 0}), -1)
+    TEST_ASSERT_EQ(heap.pop().node, 1)
+    TEST_ASSERT_EQ(heap.pop().node, 6)
+    TEST_ASSERT_TRUE(heap.is_empty())
+  }
+
+  heap.resize(6);
+  TEST_ASSERT_EQ(heap.find({2, 0}), -1)
+
+  return true;
+}
+
+bool sdizo::tests::test_lookup_heap()
+{
+  using sdizo2::dijkstra::HeapLayout;
+
+  TEST_INVOKE_ASSERT_TRUE(test_lookup_heap_layout<HeapLayout::packed>);
+  TEST_INVOKE_ASSERT_TRUE(test_lookup_heap_layout<HeapLayout::soa>);
+
+  return true;
+}
+
+bool sdizo::tests::test_heap_stats()
+{
+  // Counters exist only in builds with SDIZO_HEAP_STATS
+#ifdef SDIZO_HEAP_STATS
+  constexpr uint64_t counted = 1;
+#else
+  constexpr uint64_t counted = 0;
+#endif
+
+  // Generated graph without extra edges is path 0 -> 1 -> ... -> 9
+  constexpr int32_t size = 10;
+
+  sdizo2::dijkstra::DijkstraSolver dijkstra(size);
+  dijkstra.generate(size, 0.0);
+  dijkstra.reset_heap_stats();
+  dijkstra.solve_from(0);
+
+  // Every node is discovered once and nothing ever moves up
+  auto stats = dijkstra.get_heap_stats();
+  TEST_ASSERT_EQ(stats.inserts, size * counted)
+  TEST_ASSERT_EQ(stats.pops, size * counted)
+  TEST_ASSERT_EQ(stats.sift_steps, 0)
+  TEST_ASSERT_EQ(stats.reallocations, 0)
+
+  // Both passes push every edge and pop until heap is empty, heap of
+  // 4 slots grows by 4 twice to fit 9 edges in first pass
+  sdizo2::KruskalSolver kruskal(size);
+  kruskal.generate(size, 0.0);
+  kruskal.reset_heap_stats();
+  kruskal.solve();
+
+  stats = kruskal.get_heap_stats();
+  TEST_ASSERT_EQ(stats.inserts, 2 * (size - 1) * counted)
+  TEST_ASSERT_EQ(stats.pops, 2 * (size - 1) * counted)
+  TEST_ASSERT_EQ(stats.reallocations, 2 * counted)
+
+  // On path only one edge leads out of visited nodes at a time
+  sdizo2::PrimSolver prim(size);
+  prim.generate(size, 0.0);
+  prim.reset_heap_stats();
+  prim.solve();
+
+  stats = prim.get_heap_stats();
+  TEST_ASSERT_EQ(stats.inserts, 2 * (size - 1) * counted)
+  TEST_ASSERT_EQ(stats.pops, 2 * (size - 1) * counted)
+  TEST_ASSERT_EQ(stats.sift_steps, 0)
+  TEST_ASSERT_EQ(stats.reallocations, 0)
+
+  return true;
+}
+
+bool sdizo::tests::test_dijkstra_queries()
+{
+  #if TESTS_CPP_17 == true
+    constexpr int32_t node_cnt = 200;
+    constexpr int32_t edge_cnt = 2000;
+
+    const char *filename = "testgraph";
+    std::ofstream file(filename);
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int32_t> node_dist(0, node_cnt - 1);
+    std::uniform_int_distribution<int32_t> weight_dist(1, 20);
+
+    file << edge_cnt << ' ' << node_cnt << ' ' << 0 << '\n';
+    for(int32_t i = 0; i < edge_cnt; ++i)
+      file << node_dist(generator) << ' ' << node_dist(generator) << ' '
+           << weight_dist(generator) << '\n';
+    file.close();
+
+    // Workspace left by previous queries must not leak into next one
+    sdizo2::dijkstra::DijkstraSolver reused(0);
+    reused.loadFromFile(filename);
+
+    for(int32_t source : {0, 17, 17, 199, 3, 0, 120})
+    {
+      sdizo2::dijkstra::DijkstraSolver fresh(0);
+      fresh.loadFromFile(filename);
+
+      reused.solve_from(source);
+      fresh.solve_from(source);
+
+      auto &expected = fresh.get_cost_source_table();
+      auto &actual = reused.get_cost_source_table();
+      for(int32_t node = 0; node < node_cnt; ++node)
+      {
+        TEST_ASSERT_EQ(actual.get_cost(node), expected.get_cost(node))
+        TEST_ASSERT_EQ(actual.get_source(node), expected.get_source(node))
+      }
+    }
+
+    std::filesystem::remove(filename);
+
+    // Invalid source is rejected before previous results are dropped
+    bool thrown = false;
+    try{
+      reused.solve_from(node_cnt);
+    }catch(std::out_of_range&){
+      thrown = true;
+    }
+    TEST_ASSERT_TRUE(thrown)
+    TEST_ASSERT_EQ(reused.get_cost_source_table().get_cost(120), 0)
+  #endif
+
+  return true;
+}
+
 bool sdizo::tests::test_bst()
 {
-  using sdizo::Tree;
+  using sdizo::Tree;
+
+  Tree tree;
+  TEST_INVOKE_ASSERT_FALSE(tree.search, 2);
+  tree.insert(23);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+  tree.insert(123);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+  tree.insert(12);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+  tree.insert(1);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+  tree.insert(2);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+  TEST_INVOKE_ASSERT_FALSE(tree.search, 1337);
+  tree.insert(1337);
+  TEST_INVOKE_ASSERT_TRUE(tree.search, 1337);
+
+  auto pred = tree.predecessor(tree.search(2));
+  TEST_ASSERT_EQ(pred->value, 1);
+
+  pred = tree.predecessor(tree.search(1));
+  TEST_ASSERT_EQ(pred, nullptr);
+
+  return true;
+}
+
+bool sdizo::tests::test_bst2()
+{
+  sdizo::Tree tree;
+  tree.insert(10);
+  tree.insert(7);
+  tree.insert(13);
+  tree.insert(6);
+  tree.insert(1);
+  tree.insert(15);
+  tree.insert(14);
+  tree.dsw();
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_connections);
+
+  return true;
+}
+
+bool sdizo::tests::test_bst3()
+{
+  // Sorted input degenerates tree into list
+  constexpr int32_t size = 4000;
+  sdizo::Tree tree;
+
+  for(int32_t round = 0; round < 2; ++round)
+  {
+    for(int32_t i = 0; i < size; ++i)
+      tree.insert(i);
+
+    TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+    TEST_INVOKE_ASSERT_TRUE(tree.verify_connections);
+
+    tree.remove(tree.search(size/2));
+    TEST_INVOKE_ASSERT_FALSE(tree.search, size/2);
+    tree.insert(size/2);
+    TEST_INVOKE_ASSERT_TRUE(tree.search, size/2);
+
+    tree.clear();
+    TEST_ASSERT_EQ(tree.root, nullptr);
+  }
+
+  return true;
+}
+
+bool sdizo::tests::test_bst_bulk_build()
+{
+  constexpr int32_t size = 100000;
+  std::vector<int32_t> values(size);
+  for(int32_t i = 0; i < size; ++i)
+    values[i] = i / 3;
+
+  sdizo::Tree tree;
+  for(bool parallel : {false, true})
+  {
+    tree.bulk_build(values.data(), values.data() + size, parallel);
+    TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+    TEST_INVOKE_ASSERT_TRUE(tree.verify_connections);
+
+    for(int32_t i = 0; i < size; i += 7)
+      TEST_ASSERT_TRUE(tree.search(values[i]) != nullptr)
+
+    TEST_ASSERT_EQ(tree.search(size), nullptr)
+    TEST_ASSERT_EQ(sdizo::Tree::min(tree.root)->value, values[0])
+    TEST_ASSERT_EQ(sdizo::Tree::max(tree.root)->value, values[size-1])
+  }
+
+  tree.bulk_build(values.data(), values.data());
+  TEST_ASSERT_EQ(tree.root, nullptr)
+
+  // Equal values can only form right chain, but building it must not
+  // rescan the run at every node (quadratic time on such input)
+  std::fill(values.begin(), values.end() - 10, 7);
+  std::fill(values.end() - 10, values.end(), 8);
+  tree.bulk_build(values.data(), values.data() + size);
+
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_connections);
+  TEST_ASSERT_EQ(sdizo::Tree::min(tree.root)->value, 7)
+  TEST_ASSERT_EQ(sdizo::Tree::max(tree.root)->value, 8)
+
+  return true;
+}
+
+static int32_t tree_height(const sdizo::TreeNode *node)
+{
+  if(node == nullptr)
+    return 0;
+
+  return 1 + std::max(tree_height(node->left), tree_height(node->right));
+}
+
+bool sdizo::tests::test_bst_scapegoat()
+{
+  constexpr int32_t size = 20000;
+  sdizo::Tree tree(sdizo::TreeBalance::scapegoat);
+
+  // Sorted input would degenerate plain tree into list
+  for(int32_t i = 0; i < size; ++i)
+    tree.insert(i);
+
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_connections);
+  TEST_ASSERT_EQ(tree.get_size(), size)
+  TEST_ASSERT_TRUE(tree_height(tree.root) <= 2 + std::log(size)/std::log(1.5))
+
+  for(int32_t i = 0; i < size; i += 2)
+    tree.remove(tree.search(i));
+
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_connections);
+  TEST_ASSERT_EQ(tree.get_size(), size/2)
+  TEST_ASSERT_TRUE(tree_height(tree.root) <= 2 + std::log(size)/std::log(1.5))
+
+  for(int32_t i = 0; i < size; ++i)
+    TEST_ASSERT_EQ(tree.search(i) != nullptr, i % 2 == 1)
+
+  return true;
+}
+
+bool sdizo::tests::test_bst_snapshot()
+{
+  sdizo::Tree tree;
+
+  {
+    auto empty = tree.snapshot();
+    TEST_ASSERT_EQ(empty.min(), nullptr)
+    TEST_ASSERT_FALSE(empty.contains(0))
+  }
+
+  for(int32_t size : {1, 2, 7, 100, 1000})
+  {
+    tree.clear();
+    tree.generate(-500, 500, size);
+
+    auto snapshot = tree.snapshot();
+    TEST_ASSERT_EQ(snapshot.get_size(), size)
+    TEST_ASSERT_EQ(*snapshot.min(), sdizo::Tree::min(tree.root)->value)
+    TEST_ASSERT_EQ(*snapshot.max(), sdizo::Tree::max(tree.root)->value)
+
+    for(int32_t value = -510; value <= 510; ++value)
+    {
+      TEST_ASSERT_EQ(snapshot.contains(value), tree.search(value) != nullptr)
+
+      // Smallest greater and largest smaller values from tree
+      const sdizo::TreeNode *succ = nullptr;
+      const sdizo::TreeNode *pred = nullptr;
+      for(auto node = sdizo::Tree::min(tree.root); node != nullptr;
+          node = sdizo::Tree::successor(node))
+      {
+        if(node->value < value)
+          pred = node;
+
+        if(node->value > value && succ == nullptr)
+          succ = node;
+      }
+
+      auto snap_succ = snapshot.successor(value);
+      auto snap_pred = snapshot.predecessor(value);
+      TEST_ASSERT_EQ(snap_succ == nullptr, succ == nullptr)
+      TEST_ASSERT_EQ(snap_pred == nullptr, pred == nullptr)
+      TEST_ASSERT_TRUE(succ == nullptr || *snap_succ == succ->value)
+      TEST_ASSERT_TRUE(pred == nullptr || *snap_pred == pred->value)
+    }
+  }
+
+  return true;
+}
+
+bool sdizo::tests::test_bst_splay()
+{
+  sdizo::Tree tree(sdizo::TreeBalance::splay);
+
+  for(int32_t i = 0; i < 1000; ++i)
+    tree.insert((i * 7919) % 1000);
+
+  TEST_ASSERT_EQ(tree.root->value, (999 * 7919) % 1000)
+
+  for(int32_t i : {500, 3, 999, 500, 0})
+  {
+    TEST_ASSERT_TRUE(tree.access(i) != nullptr)
+    TEST_ASSERT_EQ(tree.root->value, i)
+  }
+
+  TEST_ASSERT_EQ(tree.access(1000), nullptr)
+  TEST_ASSERT_EQ(tree.root->value, 999)
+
+  for(int32_t i = 0; i < 1000; i += 3)
+    tree.remove(tree.access(i));
+
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_connections);
+
+  for(int32_t i = 0; i < 1000; ++i)
+    TEST_ASSERT_EQ(tree.search(i) != nullptr, i % 3 != 0)
+
+  // Duplicates are not inserted, existing node is splayed instead
+  sdizo::Tree duplicates(sdizo::TreeBalance::splay);
+  duplicates.insert(5);
+  duplicates.insert(3);
+  duplicates.insert(5);
+  TEST_INVOKE_ASSERT_TRUE(duplicates.verify_values);
+  TEST_ASSERT_EQ(duplicates.get_size(), 2)
+  TEST_ASSERT_EQ(duplicates.root->value, 5)
+
+  for(int32_t i = 0; i < 1000; ++i)
+    duplicates.insert((i * 7919) % 100);
+
+  TEST_INVOKE_ASSERT_TRUE(duplicates.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(duplicates.verify_connections);
+  TEST_ASSERT_EQ(duplicates.get_size(), 100)
+
+  int32_t sorted[] = {1, 1, 2, 2, 2, 3};
+  duplicates.bulk_build(sorted, sorted + 6);
+  TEST_ASSERT_EQ(duplicates.get_size(), 3)
+  duplicates.insert(2);
+  TEST_INVOKE_ASSERT_TRUE(duplicates.verify_values);
+  TEST_ASSERT_EQ(duplicates.get_size(), 3)
+
+  return true;
+}
+
+bool sdizo::tests::test_rbt()
+{
+  sdizo::RedBlackTree rbt;
+  for(int i = 0; i < 10; ++i)
+  {
+    rbt.insert(i);
+  }
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
+  for(int i = 0; i < 10; ++i)
+  {
+    rbt.remove(i);
+  }
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
+  for(int i = 0; i < 10; ++i)
+  {
+    rbt.insert(i);
+  }
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
+  for(int i = 0; i < 10; ++i)
+  {
+    rbt.remove(i);
+  }
+  rbt.remove(123);
+  rbt.remove(123);
+  rbt.remove(123);
+  rbt.remove(123);
+  rbt.insert(123123);
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
+  return true;
+}
+
+bool sdizo::tests::test_rbt_bulk()
+{
+  std::vector<int32_t> values;
+  for(int32_t size = 0; size < 100; ++size)
+  {
+    sdizo::RedBlackTree rbt;
+    rbt.bulk_load(values.data(), values.data() + values.size());
+
+    TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
+    TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
+    TEST_INVOKE_ASSERT_TRUE(rbt.verify_colors);
+
+    for(int32_t i = 0; i < size; ++i)
+      TEST_ASSERT_TRUE(rbt.contains(i * 2))
+
+    TEST_ASSERT_FALSE(rbt.contains(size * 2))
+    values.push_back(size * 2);
+  }
+
+  // Empty range leaves tree empty and guard node untouched
+  {
+    sdizo::RedBlackTree rbt;
+    auto guard = rbt.get_root();
+    rbt.bulk_load(values.data(), values.data());
+    TEST_ASSERT_EQ(rbt.get_root(), guard)
+    TEST_ASSERT_EQ(guard->parent, nullptr)
+    TEST_ASSERT_TRUE(guard->color == sdizo::NodeColor::black)
+
+    rbt.bulk_load(values.data(), values.data() + values.size());
+    rbt.bulk_load(values.data(), values.data());
+    TEST_ASSERT_EQ(rbt.get_root(), guard)
+    TEST_ASSERT_FALSE(rbt.contains(0))
+    TEST_ASSERT_EQ(rbt.begin(), rbt.end())
+  }
+
+  // Merge sorted batches of odd values into tree of even values
+  sdizo::RedBlackTree rbt;
+  rbt.bulk_load(values.data(), values.data() + values.size());
+
+  std::mt19937 generator(11);
+  std::vector<int32_t> odd;
+  for(int32_t i = 0; i < 100; ++i)
+    odd.push_back(i * 2 + 1);
+  std::shuffle(odd.begin(), odd.end(), generator);
+
+  for(int32_t batch = 0; batch < 100; batch += 25)
+  {
+    std::sort(odd.begin() + batch, odd.begin() + batch + 25);
+    rbt.bulk_insert(odd.data() + batch, odd.data() + batch + 25);
+
+    TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
+    TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
+    TEST_INVOKE_ASSERT_TRUE(rbt.verify_colors);
+  }
+
+  for(int32_t i = 0; i < 200; ++i)
+    TEST_ASSERT_TRUE(rbt.contains(i))
+
+  for(int32_t i = 0; i < 200; i += 3)
+    rbt.remove(i);
+
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_colors);
+
+  for(int32_t i = 0; i < 200; ++i)
+    TEST_ASSERT_EQ(rbt.contains(i), i % 3 != 0)
+
+  return true;
+}
+
+bool sdizo::tests::test_rbt_order_statistics()
+{
+  // Flag has to be passed explicitly, bool is not a tree
+  static_assert(!std::is_convertible_v<bool, sdizo::RedBlackTree>);
+
+  sdizo::RedBlackTree rbt(true);
+  std::mt19937 generator(13);
+  std::uniform_int_distribution<int32_t> distribution(0, 499);
+  std::vector<bool> present(500, false);
+
+  for(int32_t i = 0; i < 5000; ++i)
+  {
+    auto value = distribution(generator);
+    if(present[value])
+      rbt.remove(value);
+    else
+      rbt.insert(value);
+    present[value] = !present[value];
+  }
+
+  // Merge in all missing multiples of 7
+  std::vector<int32_t> batch;
+  for(int32_t i = 0; i < 500; i += 7)
+    if(!present[i])
+    {
+      batch.push_back(i);
+      present[i] = true;
+    }
+  rbt.bulk_insert(batch.data(), batch.data() + batch.size());
+
+  std::vector<int32_t> sorted;
+  for(int32_t i = 0; i < 500; ++i)
+  {
+    TEST_ASSERT_EQ(rbt.rank(i), static_cast<int32_t>(sorted.size()))
+    if(present[i])
+      sorted.push_back(i);
+  }
+
+  for(int32_t k = 0; k < static_cast<int32_t>(sorted.size()); ++k)
+    TEST_ASSERT_EQ(rbt.select(k), sorted[k])
+
+  auto expected = std::count_if(sorted.begin(), sorted.end(),
+                                [](int32_t v){return v >= 100 && v < 250;});
+  TEST_ASSERT_EQ(rbt.range_count(100, 250), expected)
+  TEST_ASSERT_EQ(rbt.range_count(250, 100), 0)
+
+  try{
+    // should throw
+    rbt.select(sorted.size());
+    return false;
+  }catch(std::out_of_range &e){}
+
+  sdizo::RedBlackTree plain;
+  try{
+    // should throw, order statistics not enabled
+    plain.rank(0);
+    return false;
+  }catch(std::logic_error &e){}
+
+  return true;
+}
+
+// Orders DijkstraNodes by node, lookups may use bare node number.
+struct DijkstraNodeLess
+{
+  using is_transparent = void;
+
+  static int32_t node(const sdizo2::dijkstra::DijkstraNode &n) {return n.node;}
+  static int32_t node(int32_t n) {return n;}
+
+  template<typename A, typename B>
+  bool operator()(const A &a, const B &b) const
+  {return node(a) < node(b);}
+};
+
+bool sdizo::tests::test_rbt_map()
+{
+  using sdizo2::dijkstra::DijkstraNode;
+
+  // Former guard value is ordinary key now
+  sdizo::RedBlackTree rbt;
+  rbt.insert(INT32_MIN);
+  rbt.insert(0);
+  TEST_ASSERT_TRUE(rbt.contains(INT32_MIN))
+  rbt.remove(INT32_MIN);
+  TEST_ASSERT_FALSE(rbt.contains(INT32_MIN))
+
+  sdizo::RedBlackMap<int32_t, int32_t> map;
+  for(int32_t i = 0; i < 100; ++i)
+    map.insert(i, i * i);
+
+  // Removing nodes with two childs moves successor into their place
+  for(int32_t i = 0; i < 100; i += 2)
+    map.remove(i);
+
+  TEST_INVOKE_ASSERT_TRUE(map.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(map.verify_colors);
+
+  for(int32_t i = 0; i < 100; ++i)
+  {
+    auto mapped = map.find(i);
+    TEST_ASSERT_EQ(mapped == nullptr, i % 2 == 0)
+    TEST_ASSERT_TRUE(mapped == nullptr || *mapped == i * i)
+  }
+
+  sdizo::RedBlackMap<DijkstraNode, const char*, DijkstraNodeLess> nodes(true);
+  nodes.insert({3, 10}, "c");
+  nodes.insert({1, 30}, "a");
+  nodes.insert({2, 20}, "b");
+
+  TEST_ASSERT_TRUE(nodes.contains(2))
+  TEST_ASSERT_FALSE(nodes.contains(4))
+  TEST_ASSERT_EQ(*nodes.find(1), std::string_view("a"))
+  TEST_ASSERT_EQ(nodes.search(3)->value.cost, 10)
+  TEST_ASSERT_EQ(nodes.rank(3), 2)
+  TEST_ASSERT_EQ(nodes.select(0).cost, 30)
+
+  return true;
+}
+
+// Fills tree with unique random values, returns them sorted.
+static std::vector<int32_t> fill_unique(sdizo::RedBlackTree &rbt,
+                                        int32_t count, int32_t range,
+                                        std::mt19937 &generator)
+{
+  std::vector<int32_t> values(range);
+  for(int32_t i = 0; i < range; ++i)
+    values[i] = i;
+
+  std::shuffle(values.begin(), values.end(), generator);
+  values.resize(count);
+
+  for(auto value : values)
+    rbt.insert(value);
+
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+static bool rbt_holds(const sdizo::RedBlackTree &rbt,
+                      const std::vector<int32_t> &values, int32_t range)
+{
+  if(!rbt.verify_values() || !rbt.verify_colors())
+    return false;
+
+  for(int32_t i = 0; i < range; ++i)
+    if(rbt.contains(i) != std::binary_search(values.begin(), values.end(), i))
+      return false;
+
+  return rbt.has_order_statistics() ?
+    rbt.rank(range) == static_cast<int32_t>(values.size()) : true;
+}
+
+bool sdizo::tests::test_rbt_set_operations()
+{
+  constexpr int32_t range = 6000;
+  std::mt19937 generator(17);
+
+  for(bool parallel : {false, true})
+  {
+    std::vector<int32_t> expected;
+
+    sdizo::RedBlackTree a(true), b;
+    auto a_values = fill_unique(a, 3000, range, generator);
+    auto b_values = fill_unique(b, 2000, range, generator);
+    a.set_union(b, parallel);
+
+    std::set_union(a_values.begin(), a_values.end(),
+                   b_values.begin(), b_values.end(),
+                   std::back_inserter(expected));
+    TEST_ASSERT_TRUE(rbt_holds(a, expected, range))
+    TEST_ASSERT_FALSE(b.contains(b_values[0]))
+
+    sdizo::RedBlackTree c, d(true);
+    auto c_values = fill_unique(c, 500, range, generator);
+    auto d_values = fill_unique(d, 4000, range, generator);
+    c.set_intersection(d, parallel);
+
+    expected.clear();
+    std::set_intersection(c_values.begin(), c_values.end(),
+                          d_values.begin(), d_values.end(),
+                          std::back_inserter(expected));
+    TEST_ASSERT_TRUE(rbt_holds(c, expected, range))
+
+    sdizo::RedBlackTree e(true), f;
+    auto e_values = fill_unique(e, 4000, range, generator);
+    auto f_values = fill_unique(f, 3000, range, generator);
+    e.set_difference(f, parallel);
+
+    expected.clear();
+    std::set_difference(e_values.begin(), e_values.end(),
+                        f_values.begin(), f_values.end(),
+                        std::back_inserter(expected));
+    TEST_ASSERT_TRUE(rbt_holds(e, expected, range))
+
+    // Tree is still usable after its nodes were shuffled around
+    e.insert(range);
+    e.remove(expected[0]);
+    TEST_INVOKE_ASSERT_TRUE(e.verify_colors);
+  }
+
+  sdizo::RedBlackTree left, right;
+  auto values = fill_unique(left, 1000, 2000, generator);
+  left.split(1000, right);
+
+  auto middle = std::lower_bound(values.begin(), values.end(), 1000);
+  TEST_ASSERT_TRUE(rbt_holds(left, {values.begin(), middle}, 2000))
+  TEST_ASSERT_TRUE(rbt_holds(right, {middle, values.end()}, 2000))
+
+  left.join(right);
+  TEST_ASSERT_TRUE(rbt_holds(left, values, 2000))
+  TEST_ASSERT_FALSE(right.contains(values.back()))
+
+  // Part moved to tree keeping sizes gets them computed
+  std::vector<int32_t> hundred;
+  for(int32_t i = 0; i < 100; ++i)
+    hundred.push_back(i);
+
+  for(bool lower_counts : {false, true})
+  {
+    sdizo::RedBlackTree lower(lower_counts), upper(!lower_counts);
+    for(auto value : hundred)
+      lower.insert(value);
+
+    lower.split(50, upper);
+    auto &counting = lower_counts ? lower : upper;
+    auto offset = lower_counts ? 0 : 50;
+    TEST_ASSERT_TRUE(counting.rank(offset + 25) == 25)
+    TEST_ASSERT_TRUE(counting.rank(100) == 50)
+
+    lower.join(upper);
+    TEST_ASSERT_TRUE(rbt_holds(lower, hundred, 100))
+  }
+
+  return true;
+}
+
+bool sdizo::tests::test_rbt_iteration()
+{
+  sdizo::RedBlackTree rbt;
+  std::mt19937 generator(17);
+  std::uniform_int_distribution<int32_t> distribution(0, 4999);
+  std::vector<int32_t> values;
+
+  TEST_ASSERT_TRUE(rbt.begin() == rbt.end())
+  TEST_ASSERT_TRUE(--rbt.end() == rbt.end())
+
+  // Equal elements included
+  for(int32_t i = 0; i < 3000; ++i)
+  {
+    auto value = distribution(generator);
+    values.push_back(value);
+    rbt.insert(value);
+  }
+  std::sort(values.begin(), values.end());
+
+  TEST_ASSERT_TRUE(std::equal(rbt.begin(), rbt.end(),
+                              values.begin(), values.end()))
+
+  auto position = rbt.end();
+  for(auto it = values.rbegin(); it != values.rend(); ++it)
+  {
+    --position;
+    TEST_ASSERT_EQ(*position, *it)
+  }
+  TEST_ASSERT_TRUE(position == rbt.begin())
+
+  for(int32_t probe = -1; probe <= 5000; probe += 7)
+  {
+    auto lower = std::lower_bound(values.begin(), values.end(), probe);
+    auto upper = std::upper_bound(values.begin(), values.end(), probe);
+
+    TEST_ASSERT_EQ(std::distance(rbt.begin(), rbt.lower_bound(probe)),
+                   lower - values.begin())
+    TEST_ASSERT_EQ(std::distance(rbt.begin(), rbt.upper_bound(probe)),
+                   upper - values.begin())
+  }
+
+  std::vector<int32_t> scanned;
+  rbt.scan(1000, 2000, [&](int32_t value){scanned.push_back(value);});
+  TEST_ASSERT_TRUE(std::equal(scanned.begin(), scanned.end(),
+                   std::lower_bound(values.begin(), values.end(), 1000),
+                   std::lower_bound(values.begin(), values.end(), 2000)))
+
+  // Predecessor of node with left child is maximum of left subtree
+  auto root = rbt.get_root();
+  auto root_index = 0;
+  for(auto it = rbt.begin(); it.get_node() != root; ++it)
+    ++root_index;
+  TEST_ASSERT_EQ(rbt.predecessor(root)->value, values[root_index - 1])
+
+  sdizo::RedBlackMap<int32_t, int32_t> map;
+  for(int32_t i = 0; i < 100; ++i)
+    map.insert(i, i * i);
+
+  int32_t sum = 0;
+  map.scan(10, 20, [&](int32_t key, int32_t &mapped){
+    sum += mapped - key * key;
+    ++mapped;
+  });
+  TEST_ASSERT_EQ(sum, 0)
+  TEST_ASSERT_EQ(*map.find(15), 226)
+  TEST_ASSERT_EQ(map.lower_bound(20).get_node()->mapped, 400)
+  return true;
+}
+
+bool sdizo::tests::test_rbt_hinted_insert()
+{
+  sdizo::RedBlackTree ascending(true);
+  for(int32_t i = 0; i < 5000; ++i)
+    ascending.insert(i);
+
+  TEST_INVOKE_ASSERT_TRUE(ascending.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(ascending.verify_colors);
+  TEST_ASSERT_EQ(ascending.rank(2500), 2500)
+
+  // Maximum removed, finger has to be found again
+  ascending.remove(4999);
+  ascending.insert(4999);
+  ascending.insert(6000);
+  ascending.remove(6000);
+  ascending.insert(5000);
+  TEST_INVOKE_ASSERT_TRUE(ascending.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(ascending.verify_colors);
+  TEST_ASSERT_EQ(ascending.select(5000), 5000)
+
+  sdizo::RedBlackTree descending(true);
+  for(int32_t i = 5000; i > 0; --i)
+    descending.insert(descending.begin(), i);
+
+  TEST_INVOKE_ASSERT_TRUE(descending.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(descending.verify_colors);
+  TEST_ASSERT_EQ(descending.rank(2500), 2499)
+
+  // Hint from lower_bound is always right, wrong hints are ignored
+  sdizo::RedBlackTree tree;
+  std::mt19937 generator(19);
+  std::uniform_int_distribution<int32_t> distribution(0, 99999);
+  std::vector<int32_t> values;
+  for(int32_t i = 0; i < 5000; ++i)
+  {
+    auto value = distribution(generator);
+    if(tree.contains(value))
+      continue;
+
+    if(i % 2)
+      tree.insert(tree.lower_bound(value), value);
+    else
+      tree.insert(tree.begin(), value);
+
+    values.push_back(value);
+  }
+  std::sort(values.begin(), values.end());
+
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_connections);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify_colors);
+  TEST_ASSERT_TRUE(std::equal(tree.begin(), tree.end(),
+                              values.begin(), values.end()))
+
+  // Duplicate hinted with itself goes right of it, like plain insert
+  sdizo::RedBlackTree duplicates;
+  duplicates.insert(5);
+  duplicates.insert(duplicates.begin(), 5);
+  TEST_INVOKE_ASSERT_TRUE(duplicates.verify_values);
+
+  // Rotations may move equal keys left, so only order is checked
+  duplicates.insert(7);
+  for(int32_t i = 0; i < 100; ++i)
+  {
+    duplicates.insert(duplicates.lower_bound(5), 5);
+    duplicates.insert(duplicates.upper_bound(5), 5);
+  }
+
+  TEST_ASSERT_TRUE(std::is_sorted(duplicates.begin(), duplicates.end()))
+  TEST_INVOKE_ASSERT_TRUE(duplicates.verify_colors);
+  TEST_ASSERT_EQ(std::distance(duplicates.begin(), duplicates.end()), 203)
+  TEST_ASSERT_EQ(*--duplicates.end(), 7)
+  return true;
+}
+
+bool sdizo::tests::test_rbt_filter()
+{
+  sdizo::RedBlackTree rbt;
+  std::vector<int32_t> values;
+  for(int32_t i = 0; i < 20000; ++i)
+    values.push_back(i * 2);
+
+  rbt.bulk_load(values.data(), values.data() + values.size());
+  rbt.enable_filter(0.01);
+  TEST_ASSERT_TRUE(rbt.get_filter() != nullptr)
+
+  // Odd keys are absent, about 1% of them pass the filter
+  int32_t passed = 0;
+  for(int32_t i = 0; i < 20000; ++i)
+  {
+    TEST_ASSERT_TRUE(rbt.contains(i * 2))
+    TEST_ASSERT_FALSE(rbt.contains(i * 2 + 1))
+
+    auto hash = sdizo::mix_hash(i * 2 + 1);
+    passed += rbt.get_filter()->may_contain(hash);
+  }
+  TEST_ASSERT_TRUE(passed < 20000 * 0.03)
+  TEST_ASSERT_TRUE(rbt.get_filter()->false_positive_rate() < 0.01)
+
+  // Filter grows with inserts and is rebuilt after removes
+  for(int32_t i = 40000; i < 100000; ++i)
+    rbt.insert(i);
+  for(int32_t i = 0; i < 40000; i += 2)
+    rbt.remove(i);
+
+  TEST_ASSERT_TRUE(rbt.get_filter()->get_capacity() >= 60000)
+  for(int32_t i = 0; i < 100000; ++i)
+    TEST_ASSERT_EQ(rbt.contains(i), i >= 40000)
+
+  // Keys added by joins and bulk inserts pass filter too
+  sdizo::RedBlackTree right;
+  right.enable_filter(0.05);
+  right.insert(200000);
+  rbt.join(right);
+  TEST_ASSERT_TRUE(rbt.contains(200000))
+  TEST_ASSERT_FALSE(right.contains(200000))
+
+  std::vector<int32_t> batch = {-3, -2, -1};
+  rbt.bulk_insert(batch.data(), batch.data() + batch.size());
+  TEST_ASSERT_TRUE(rbt.contains(-2))
+
+  rbt.split(50000, right);
+  TEST_ASSERT_TRUE(right.contains(200000))
+  TEST_ASSERT_TRUE(right.contains(50000))
+  TEST_ASSERT_FALSE(rbt.contains(50000))
+
+  rbt.clear();
+  TEST_ASSERT_FALSE(rbt.contains(-2))
+  rbt.disable_filter();
+  TEST_ASSERT_TRUE(rbt.get_filter() == nullptr)
+  return true;
+}
+
+bool sdizo::tests::test_compact_rbt()
+{
+  sdizo::CompactRedBlackTree rbt;
+  std::mt19937 generator(5);
+  std::uniform_int_distribution<int32_t> distribution(0, 999);
+  std::vector<int32_t> counts(1000, 0);
+
+  for(int32_t i = 0; i < 20000; ++i)
+  {
+    auto value = distribution(generator);
+    // verify_values expects keys to be unique
+    if(counts[value])
+    {
+      rbt.remove(value);
+      counts[value] = 0;
+    }
+    else
+    {
+      rbt.insert(value);
+      counts[value] = 1;
+    }
+  }
+
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_colors);
+
+  int32_t size = 0;
+  for(int32_t i = 0; i < 1000; ++i)
+  {
+    TEST_ASSERT_EQ(rbt.contains(i), counts[i] > 0)
+    size += counts[i];
+  }
+  TEST_ASSERT_EQ(rbt.get_size(), size)
+
+  // Copy shares no memory with original, moves keep content
+  sdizo::CompactRedBlackTree copy(rbt);
+  copy.insert(5000);
+  copy.remove(5000);
+  for(int32_t i = 0; i < 1000; ++i)
+  {
+    if(counts[i])
+      copy.remove(i);
+    else
+      copy.insert(i);
+  }
+  TEST_INVOKE_ASSERT_TRUE(copy.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(copy.verify_colors);
+  TEST_ASSERT_EQ(copy.get_size(), 1000 - size)
+
+  for(int32_t i = 0; i < 1000; ++i)
+  {
+    TEST_ASSERT_EQ(rbt.contains(i), counts[i] > 0)
+    TEST_ASSERT_EQ(copy.contains(i), counts[i] == 0)
+  }
+
+  sdizo::CompactRedBlackTree moved(std::move(copy));
+  TEST_ASSERT_EQ(moved.get_size(), 1000 - size)
+  TEST_INVOKE_ASSERT_TRUE(moved.verify_colors);
+
+  copy = rbt;
+  moved = std::move(copy);
+  TEST_ASSERT_EQ(moved.get_size(), size)
+  TEST_INVOKE_ASSERT_TRUE(moved.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(moved.verify_connections);
+  TEST_INVOKE_ASSERT_TRUE(moved.verify_colors);
+
+  for(int32_t i = 0; i < 1000; ++i)
+    if(counts[i])
+      rbt.remove(i);
+
+  TEST_ASSERT_EQ(rbt.get_size(), 0)
+  TEST_ASSERT_EQ(rbt.search(0), sdizo::CompactRedBlackTree::null_index)
+
+  rbt.insert(123123);
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify_colors);
+  return true;
+}
+
+// Values of persistent tree in order.
+static void collect_values(const sdizo::PersistentRedBlackNode *node,
+                           std::vector<int32_t> &values)
+{
+  if(node == nullptr)
+    return;
+
+  collect_values(node->left, values);
+  values.push_back(node->value);
+  collect_values(node->right, values);
+}
+
+bool sdizo::tests::test_persistent_rbt()
+{
+  sdizo::PersistentRedBlackTree rbt;
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<int32_t> distribution(0, 499);
+  // Sorted contents, equal values allowed
+  std::vector<int32_t> values;
+  std::vector<sdizo::PersistentRedBlackTree> snapshots;
+  std::vector<std::vector<int32_t>> snapshot_values;
+
+  for(int32_t i = 0; i < 20000; ++i)
+  {
+    auto value = distribution(generator);
+    auto position = std::lower_bound(values.begin(), values.end(), value);
+
+    if(i % 3 == 0)
+    {
+      if(position != values.end() && *position == value)
+        values.erase(position);
+      rbt.remove(value);
+    }
+    else
+    {
+      values.insert(position, value);
+      rbt.insert(value);
+    }
+
+    if(i % 1000 == 0)
+    {
+      snapshots.push_back(rbt.snapshot());
+      snapshot_values.push_back(values);
+    }
+  }
+
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify);
+  TEST_ASSERT_EQ(rbt.get_size(), int32_t(values.size()))
+
+  std::vector<int32_t> current;
+  collect_values(rbt.get_root(), current);
+  TEST_ASSERT_TRUE(current == values)
+
+  // Later changes are not visible in snapshots
+  for(size_t i = 0; i < snapshots.size(); ++i)
+  {
+    std::vector<int32_t> snapshot;
+    collect_values(snapshots[i].get_root(), snapshot);
+    TEST_ASSERT_TRUE(snapshot == snapshot_values[i])
+    TEST_INVOKE_ASSERT_TRUE(snapshots[i].verify);
+  }
+
+  auto copy = rbt;
+  rbt.clear();
+  TEST_ASSERT_EQ(rbt.get_size(), 0)
+  TEST_ASSERT_FALSE(rbt.contains(values.front()))
+  TEST_ASSERT_TRUE(copy.contains(values.front()))
+  TEST_ASSERT_EQ(copy.get_size(), int32_t(values.size()))
+
+  snapshots.clear();
+  for(auto value : values)
+    copy.remove(value);
+
+  TEST_ASSERT_EQ(copy.get_size(), 0)
+  TEST_INVOKE_ASSERT_TRUE(copy.verify);
+  return true;
+}
+
+bool sdizo::tests::test_concurrent_rbt()
+{
+  sdizo::ConcurrentRedBlackTree rbt;
+  std::vector<int32_t> even;
+  for(int32_t i = 0; i < 2000; i += 2)
+    even.push_back(i);
 
-  Tree tree;
-  TEST_INVOKE_ASSERT_FALSE(tree.search, 2);
-  tree.insert(23);
-  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
-  tree.insert(123);
-  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
-  tree.insert(12);
-  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
-  tree.insert(1);
-  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
-  tree.insert(2);
-  TEST_INVOKE_ASSERT_TRUE(tree.verify_values);
-  TEST_INVOKE_ASSERT_FALSE(tree.search, 1337);
-  tree.insert(1337);
-  TEST_INVOKE_ASSERT_TRUE(tree.search, 1337);
+  rbt.insert(even.data(), even.data() + even.size());
 
-  auto pred = tree.predecessor(tree.search(2));
-  TEST_ASSERT_EQ(pred->value, 1);
+  std::atomic<bool> done{false};
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> readers;
 
-  pred = tree.predecessor(tree.search(1));
-  TEST_ASSERT_EQ(pred, nullptr);
+  // Even elements stay in tree while writer changes odd ones
+  for(int32_t i = 0; i < 3; ++i)
+  {
+    readers.emplace_back([&]{
+      while(!done.load())
+        for(auto element : even)
+          if(!rbt.contains(element))
+            failed.store(true);
+    });
+  }
+
+  std::mt19937 generator(13);
+  std::uniform_int_distribution<int32_t> distribution(0, 999);
+  std::vector<int32_t> counts(1000, 0);
+
+  for(int32_t i = 0; i < 5000; ++i)
+  {
+    auto odd = distribution(generator) * 2 + 1;
+    if(counts[odd / 2])
+      rbt.remove(odd);
+    else
+      rbt.insert(odd);
 
+    counts[odd / 2] ^= 1;
+  }
+
+  done.store(true);
+  for(auto &reader : readers)
+    reader.join();
+
+  TEST_ASSERT_FALSE(failed.load())
+  TEST_INVOKE_ASSERT_TRUE(rbt.verify);
+
+  int32_t size = int32_t(even.size());
+  for(int32_t i = 0; i < 1000; ++i)
+  {
+    TEST_ASSERT_EQ(rbt.contains(i * 2 + 1), counts[i] > 0)
+    size += counts[i];
+  }
+  TEST_ASSERT_EQ(rbt.get_size(), size)
+
+  rbt.clear();
+  TEST_ASSERT_FALSE(rbt.contains(0))
+  TEST_ASSERT_EQ(rbt.get_size(), 0)
   return true;
 }
 
-bool sdizo::tests::test_bst2()
+bool sdizo::tests::test_bplustree()
 {
-  sdizo::Tree tree;
-  tree.insert(10);
-  tree.insert(7);
-  tree.insert(13);
-  tree.insert(6);
-  tree.insert(1);
-  tree.insert(15);
-  tree.insert(14);
-  tree.dsw();
-  TEST_INVOKE_ASSERT_TRUE(tree.verify_connections);
+  sdizo::BPlusTree tree;
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int32_t> distribution(0, 9999);
+  std::vector<int32_t> counts(10000, 0);
+
+  // Enough keys for three levels, toggling keeps splits and merges mixed
+  for(int32_t i = 0; i < 100000; ++i)
+  {
+    auto value = distribution(generator);
+    if(counts[value])
+      tree.remove(value);
+    else
+      tree.insert(value);
+
+    counts[value] ^= 1;
+  }
+
+  TEST_INVOKE_ASSERT_TRUE(tree.verify);
+  TEST_ASSERT_TRUE(tree.get_height() >= 2)
+
+  int32_t size = 0;
+  for(int32_t i = 0; i < 10000; ++i)
+  {
+    TEST_ASSERT_EQ(tree.contains(i), counts[i] > 0)
+    size += counts[i];
+  }
+  TEST_ASSERT_EQ(tree.get_size(), size)
+
+  // Inserting present or removing missing element changes nothing
+  for(int32_t i = 0; i < 100; ++i)
+    if(counts[i])
+      tree.insert(i);
+  tree.remove(-1);
+  TEST_ASSERT_EQ(tree.get_size(), size)
+
+  std::vector<int32_t> scanned;
+  tree.scan(2500, 7500, [&](int32_t value){scanned.push_back(value);});
+
+  std::vector<int32_t> expected;
+  for(int32_t i = 2500; i < 7500; ++i)
+    if(counts[i])
+      expected.push_back(i);
+
+  TEST_ASSERT_TRUE(scanned == expected)
+
+  // Extreme keys, key_padding is a valid element too
+  tree.insert(std::numeric_limits<int32_t>::min());
+  tree.insert(sdizo::BPlusTree::key_padding);
+  TEST_ASSERT_TRUE(tree.contains(sdizo::BPlusTree::key_padding))
+  TEST_ASSERT_TRUE(tree.contains(std::numeric_limits<int32_t>::min()))
+  TEST_INVOKE_ASSERT_TRUE(tree.verify);
+  tree.remove(sdizo::BPlusTree::key_padding);
+  tree.remove(std::numeric_limits<int32_t>::min());
+
+  for(int32_t i = 0; i < 10000; ++i)
+    if(counts[i])
+      tree.remove(i);
 
+  TEST_ASSERT_EQ(tree.get_size(), 0)
+  TEST_ASSERT_EQ(tree.get_height(), 0)
+  TEST_INVOKE_ASSERT_TRUE(tree.verify);
+
+  // Ascending inserts only ever split rightmost nodes
+  for(int32_t i = 0; i < 5000; ++i)
+    tree.insert(i);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify);
+  TEST_ASSERT_EQ(tree.get_size(), 5000)
+
+  tree.clear();
+  TEST_ASSERT_FALSE(tree.contains(0))
+  TEST_INVOKE_ASSERT_TRUE(tree.verify);
   return true;
 }
 
-bool sdizo::tests::test_rbt()
+bool sdizo::tests::test_van_emde_boas()
 {
-  sdizo::RedBlackTree rbt;
-  for(int i = 0; i < 10; ++i)
+  sdizo::VanEmdeBoasTree tree;
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<int32_t> distribution(-5000, 4999);
+  std::vector<int32_t> counts(10000, 0);
+
+  // Toggling keeps clusters being created and emptied
+  for(int32_t i = 0; i < 100000; ++i)
   {
-    rbt.insert(i);
+    auto value = distribution(generator);
+    if(counts[value + 5000])
+      tree.remove(value);
+    else
+      tree.insert(value);
+
+    counts[value + 5000] ^= 1;
   }
-  TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
-  TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
-  for(int i = 0; i < 10; ++i)
+
+  TEST_INVOKE_ASSERT_TRUE(tree.verify);
+
+  int32_t size = 0;
+  for(int32_t i = 0; i < 10000; ++i)
   {
-    rbt.remove(i);
+    TEST_ASSERT_EQ(tree.contains(i - 5000), counts[i] > 0)
+    size += counts[i];
   }
-  TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
-  TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
-  for(int i = 0; i < 10; ++i)
+  TEST_ASSERT_EQ(tree.get_size(), size)
+
+  // Walking successors and predecessors visits all elements in order
+  std::vector<int32_t> expected;
+  for(int32_t i = 0; i < 10000; ++i)
+    if(counts[i])
+      expected.push_back(i - 5000);
+
+  std::vector<int32_t> ascending, descending;
+  for(int32_t value = -6000; tree.successor(value, value);)
+    ascending.push_back(value);
+  for(int32_t value = 6000; tree.predecessor(value, value);)
+    descending.push_back(value);
+
+  std::reverse(descending.begin(), descending.end());
+  TEST_ASSERT_TRUE(ascending == expected)
+  TEST_ASSERT_TRUE(descending == expected)
+
+  // Inserting present or removing missing element changes nothing
+  tree.insert(expected.front());
+  tree.remove(6000);
+  TEST_ASSERT_EQ(tree.get_size(), size)
+
+  // Extreme keys land in first and last cluster of universe
+  constexpr auto min = std::numeric_limits<int32_t>::min();
+  constexpr auto max = std::numeric_limits<int32_t>::max();
+  int32_t found;
+  tree.insert(min);
+  tree.insert(max);
+  TEST_INVOKE_ASSERT_TRUE(tree.verify);
+  TEST_ASSERT_TRUE(tree.successor(min, found) && found == expected.front())
+  TEST_ASSERT_TRUE(tree.successor(expected.back(), found) && found == max)
+  TEST_ASSERT_FALSE(tree.successor(max, found))
+  TEST_ASSERT_FALSE(tree.predecessor(min, found))
+  tree.remove(min);
+  tree.remove(max);
+
+  for(auto value : expected)
+    tree.remove(value);
+
+  TEST_ASSERT_EQ(tree.get_size(), 0)
+  TEST_ASSERT_FALSE(tree.successor(min, found))
+  TEST_INVOKE_ASSERT_TRUE(tree.verify);
+  return true;
+}
+
+bool sdizo::tests::test_hash_set()
+{
+  sdizo::HashSet set;
+  TEST_ASSERT_FALSE(set.contains(0))
+  set.remove(0);
+  TEST_INVOKE_ASSERT_TRUE(set.verify);
+
+  std::mt19937 generator(13);
+  std::uniform_int_distribution<int32_t> distribution(-5000, 4999);
+  std::vector<int32_t> counts(10000, 0);
+
+  // Toggling leaves deleted slots behind, which forces
+  // rehashes without growing
+  for(int32_t i = 0; i < 200000; ++i)
   {
-    rbt.insert(i);
+    auto value = distribution(generator);
+    if(counts[value + 5000])
+      set.remove(value);
+    else
+      set.insert(value);
+
+    counts[value + 5000] ^= 1;
   }
-  TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
-  TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
-  for(int i = 0; i < 10; ++i)
+
+  TEST_INVOKE_ASSERT_TRUE(set.verify);
+
+  int32_t size = 0;
+  for(int32_t i = 0; i < 10000; ++i)
   {
-    rbt.remove(i);
+    TEST_ASSERT_EQ(set.contains(i - 5000), counts[i] > 0)
+    size += counts[i];
   }
-  rbt.remove(123);
-  rbt.remove(123);
-  rbt.remove(123);
-  rbt.remove(123);
-  rbt.insert(123123);
-  TEST_INVOKE_ASSERT_TRUE(rbt.verify_values);
-  TEST_INVOKE_ASSERT_TRUE(rbt.verify_connections);
+  TEST_ASSERT_EQ(set.get_size(), size)
+  TEST_ASSERT_TRUE(set.get_capacity() <= 16384)
+
+  // Inserting present or removing missing element changes nothing
+  for(int32_t i = 0; i < 100; ++i)
+    if(counts[i])
+      set.insert(i - 5000);
+  set.remove(5000);
+  TEST_ASSERT_EQ(set.get_size(), size)
+
+  // Keys with equal low bits of value land apart
+  for(int32_t i = 0; i < 1000; ++i)
+    set.insert(i << 16);
+  for(int32_t i = 0; i < 1000; ++i)
+    TEST_ASSERT_TRUE(set.contains(i << 16))
+  TEST_INVOKE_ASSERT_TRUE(set.verify);
+
+  set.clear();
+  TEST_ASSERT_EQ(set.get_size(), 0)
+  TEST_ASSERT_FALSE(set.contains(1 << 16))
+
+  // Reserved table does not rehash
+  set.reserve(1000);
+  auto capacity = set.get_capacity();
+  for(int32_t i = 0; i < 1000; ++i)
+    set.insert(i);
+  TEST_ASSERT_EQ(set.get_capacity(), capacity)
+  TEST_INVOKE_ASSERT_TRUE(set.verify);
+  return true;
+}
+
+bool sdizo::tests::test_skiplist()
+{
+  sdizo::SkipList list;
+  std::mt19937 generator(17);
+  std::uniform_int_distribution<int32_t> distribution(0, 1999);
+  std::vector<int32_t> counts(2000, 0);
+
+  for(int32_t i = 0; i < 20000; ++i)
+  {
+    auto value = distribution(generator);
+    bool changed = counts[value] ? list.remove(value) : list.insert(value);
+    TEST_ASSERT_TRUE(changed)
+
+    counts[value] ^= 1;
+  }
+
+  TEST_INVOKE_ASSERT_TRUE(list.verify);
+  for(int32_t i = 0; i < 2000; ++i)
+    TEST_ASSERT_EQ(list.contains(i), counts[i] > 0)
+
+  TEST_ASSERT_FALSE(list.insert(std::find(counts.begin(), counts.end(), 1) -
+                                counts.begin()))
+  TEST_ASSERT_FALSE(list.remove(-1))
+
+  std::vector<int32_t> scanned, expected;
+  list.scan(500, 1500, [&](int32_t value){scanned.push_back(value);});
+  for(int32_t i = 500; i < 1500; ++i)
+    if(counts[i])
+      expected.push_back(i);
+  TEST_ASSERT_TRUE(scanned == expected)
+
+  int32_t next;
+  TEST_ASSERT_TRUE(list.successor(499, next) && next == expected.front())
+  TEST_ASSERT_FALSE(list.successor(std::numeric_limits<int32_t>::max(), next))
+  list.clear();
+
+  // Writers toggle own keys, readers check keys nobody touches
+  constexpr int32_t writers = 4;
+  constexpr int32_t keys = 1000;
+  for(int32_t i = 0; i < keys; ++i)
+    list.insert(-1 - i);
+
+  std::atomic<bool> done{false};
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> threads;
+  std::vector<std::vector<char>> present(writers, std::vector<char>(keys, 0));
+
+  for(int32_t id = 0; id < writers; ++id)
+  {
+    threads.emplace_back([&, id]{
+      std::mt19937 generator(id);
+      for(int32_t i = 0; i < 20000; ++i)
+      {
+        auto key = int32_t(generator() % keys);
+        auto element = key * writers + id;
+
+        // Result tells if someone else touched the key
+        bool changed = present[id][key] ? list.remove(element)
+                                        : list.insert(element);
+        if(!changed)
+          failed.store(true);
+
+        present[id][key] ^= 1;
+      }
+    });
+  }
+
+  threads.emplace_back([&]{
+    while(!done.load())
+    {
+      int32_t count = 0;
+      list.scan(-keys, 0, [&](int32_t){++count;});
+      if(count != keys || !list.contains(-keys))
+        failed.store(true);
+    }
+  });
+
+  for(int32_t i = 0; i < writers; ++i)
+    threads[i].join();
+
+  done.store(true);
+  threads.back().join();
+
+  TEST_ASSERT_FALSE(failed.load())
+  TEST_INVOKE_ASSERT_TRUE(list.verify);
+
+  int32_t size = keys;
+  for(int32_t id = 0; id < writers; ++id)
+  {
+    for(int32_t key = 0; key < keys; ++key)
+    {
+      TEST_ASSERT_EQ(list.contains(key * writers + id), present[id][key] > 0)
+      size += present[id][key];
+    }
+  }
+  TEST_ASSERT_EQ(list.get_size(), size)
+
+  // All threads fight over the same few keys
+  std::atomic<int32_t> inserted{0};
+  threads.clear();
+  for(int32_t id = 0; id < writers; ++id)
+  {
+    threads.emplace_back([&, id]{
+      std::mt19937 generator(id + writers);
+      for(int32_t i = 0; i < 20000; ++i)
+      {
+        auto element = keys * writers + int32_t(generator() % 8);
+        if(generator() % 2)
+          inserted += list.insert(element);
+        else
+          inserted -= list.remove(element);
+      }
+    });
+  }
+
+  for(auto &thread : threads)
+    thread.join();
+
+  int32_t contested = 0;
+  for(int32_t i = 0; i < 8; ++i)
+    contested += list.contains(keys * writers + i);
+
+  TEST_ASSERT_EQ(contested, inserted.load())
+  TEST_INVOKE_ASSERT_TRUE(list.verify);
   return true;
 }
 
@@ -251,6 +1691,121 @@ bool sdizo::tests::test_disjoint_set()
   return true;
 }
 
+bool sdizo::tests::test_flat_disjoint_set()
+{
+  int32_t dssize = 1000;
+  sdizo2::disjoint_set::DisjointSet ds(dssize);
+  sdizo2::disjoint_set::FlatDisjointSet flat(dssize);
+
+  for(auto i = 0; i < dssize; ++i)
+  {
+    TEST_ASSERT_EQ(flat.findSet(i), i)
+    TEST_ASSERT_EQ(flat.setSize(i), 1)
+  }
+
+  // Both forests have to split elements the same way
+  std::mt19937 generator(19);
+  std::uniform_int_distribution<int32_t> distribution(0, dssize - 1);
+  int32_t sets = dssize;
+
+  for(auto i = 0; i < 800; ++i)
+  {
+    auto a = distribution(generator);
+    auto b = distribution(generator);
+    bool joined = ds.findSet(a) != ds.findSet(b);
+
+    TEST_ASSERT_EQ(flat.unionSet(a, b), joined)
+    ds.unionSet(ds.get(a), ds.get(b));
+    sets -= joined;
+  }
+
+  std::vector<int32_t> sizes(dssize, 0);
+  int32_t roots = 0;
+  for(auto i = 0; i < dssize; ++i)
+  {
+    auto j = distribution(generator);
+    TEST_ASSERT_EQ(flat.findSet(i) == flat.findSet(j),
+                   ds.findSet(i) == ds.findSet(j))
+
+    roots += flat.findSet(i) == i;
+    ++sizes[flat.findSet(i)];
+  }
+  TEST_ASSERT_EQ(roots, sets)
+
+  for(auto i = 0; i < dssize; ++i)
+    TEST_ASSERT_EQ(flat.setSize(i), sizes[flat.findSet(i)])
+
+  // Joining everything gives single set
+  for(auto i = 1; i < dssize; ++i)
+    flat.unionSet(i - 1, i);
+  TEST_ASSERT_EQ(flat.setSize(0), dssize)
+
+  flat.reset(10);
+  TEST_ASSERT_EQ(flat.get_size(), 10)
+  TEST_ASSERT_EQ(flat.setSize(9), 1)
+  return true;
+}
+
+bool sdizo::tests::test_concurrent_disjoint_set()
+{
+  constexpr int32_t dssize = 10000;
+  constexpr int32_t threads_count = 4;
+  sdizo2::disjoint_set::ConcurrentDisjointSet ds(dssize);
+  sdizo2::disjoint_set::FlatDisjointSet flat(dssize);
+
+  // Few components of many elements, so threads keep
+  // racing to join the same sets
+  std::mt19937 generator(23);
+  std::uniform_int_distribution<int32_t> distribution(0, dssize - 1);
+  std::vector<std::pair<int32_t, int32_t>> edges(30000);
+  for(auto &edge : edges)
+  {
+    edge = {distribution(generator), distribution(generator)};
+    flat.unionSet(edge.first, edge.second);
+  }
+
+  std::atomic<int32_t> joined{0};
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> threads;
+
+  // Every thread joins all edges, in its own order
+  for(auto id = 0; id < threads_count; ++id)
+  {
+    threads.emplace_back([&, id]{
+      auto order = edges;
+      std::shuffle(order.begin(), order.end(), std::mt19937(id));
+
+      for(auto [a, b] : order)
+      {
+        joined += ds.unionSet(a, b);
+        if(!ds.sameSet(a, b))
+          failed.store(true);
+      }
+    });
+  }
+
+  for(auto &thread : threads)
+    thread.join();
+
+  TEST_ASSERT_FALSE(failed.load())
+
+  int32_t sets = 0;
+  for(auto i = 0; i < dssize; ++i)
+  {
+    auto j = distribution(generator);
+    TEST_ASSERT_EQ(ds.sameSet(i, j), flat.findSet(i) == flat.findSet(j))
+    sets += flat.findSet(i) == i;
+  }
+
+  // Each union that joined two sets was reported by one thread only
+  TEST_ASSERT_EQ(joined.load(), dssize - sets)
+
+  ds.reset(10);
+  TEST_ASSERT_FALSE(ds.sameSet(0, 9))
+  TEST_ASSERT_EQ(ds.findSet(9), 9)
+  return true;
+}
+
 bool sdizo::tests::templatize_test()
 {
   sdizo::Heap<sdizo2::Edge, sdizo::HeapType::max> edge_heap_max;
@@ -336,6 +1891,20 @@ bool sdizo::tests::run_heap_tests()
   return true;
 }
 
+bool sdizo::tests::run_lookup_heap_tests()
+{
+  if(!test_lookup_heap())
+    return false;
+
+  if(!test_heap_stats())
+    return false;
+
+  if(!test_dijkstra_queries())
+    return false;
+
+  return true;
+}
+
 bool sdizo::tests::run_bst_tests()
 {
   if(!test_bst())
@@ -344,6 +1913,21 @@ bool sdizo::tests::run_bst_tests()
   if(!test_bst2())
     return false;
 
+  if(!test_bst3())
+    return false;
+
+  if(!test_bst_bulk_build())
+    return false;
+
+  if(!test_bst_scapegoat())
+    return false;
+
+  if(!test_bst_snapshot())
+    return false;
+
+  if(!test_bst_splay())
+    return false;
+
   return true;
 }
 
@@ -352,6 +1936,68 @@ bool sdizo::tests::run_rbt_tests()
   if(!test_rbt())
     return false;
 
+  if(!test_rbt_bulk())
+    return false;
+
+  if(!test_rbt_order_statistics())
+    return false;
+
+  if(!test_rbt_map())
+    return false;
+
+  if(!test_rbt_set_operations())
+    return false;
+
+  if(!test_rbt_iteration())
+    return false;
+
+  if(!test_rbt_hinted_insert())
+    return false;
+
+  if(!test_rbt_filter())
+    return false;
+
+  if(!test_compact_rbt())
+    return false;
+
+  if(!test_persistent_rbt())
+    return false;
+
+  if(!test_concurrent_rbt())
+    return false;
+
+  return true;
+}
+
+bool sdizo::tests::run_bplustree_tests()
+{
+  if(!test_bplustree())
+    return false;
+
+  return true;
+}
+
+bool sdizo::tests::run_veb_tests()
+{
+  if(!test_van_emde_boas())
+    return false;
+
+  return true;
+}
+
+bool sdizo::tests::run_hash_set_tests()
+{
+  if(!test_hash_set())
+    return false;
+
+  return true;
+}
+
+bool sdizo::tests::run_skiplist_tests()
+{
+  if(!test_skiplist())
+    return false;
+
   return true;
 }
 
@@ -360,6 +2006,12 @@ bool sdizo::tests::run_disjoint_set_tests()
   if(!test_disjoint_set())
     return false;
 
+  if(!test_flat_disjoint_set())
+    return false;
+
+  if(!test_concurrent_disjoint_set())
+    return false;
+
   return true;
 }
 
@@ -1,34 +1,127 @@
 #include "tree.hpp"
+#include "treesnapshot.hpp"
 #include "treeprinter.hpp"
 #include <stdio.h>
 #include <cassert>
 #include <stdexcept>
 #include <cmath>
 #include <random>
+#include <new>
+#include <vector>
+#include <thread>
+#include <algorithm>
 
 using sdizo::TreeNode;
 
-sdizo::Tree::Tree() noexcept
-:root{nullptr} {}
+sdizo::TreeNodeArena::TreeNodeArena() noexcept
+:first{nullptr}, current{nullptr}, used{0}, free_list{nullptr} {}
 
-sdizo::Tree::~Tree() noexcept
+sdizo::TreeNodeArena::~TreeNodeArena() noexcept
+{
+  while(this->first != nullptr)
+  {
+    Chunk *next = this->first->next;
+    delete this->first;
+    this->first = next;
+  }
+}
+
+TreeNode *sdizo::TreeNodeArena::alloc(int32_t element) noexcept
+{
+  if(this->free_list != nullptr)
+  {
+    TreeNode *node = this->free_list;
+    this->free_list = node->left;
+    return new(node) TreeNode(element);
+  }
+
+  if(this->current == nullptr)
+  {
+    this->first = new Chunk;
+    this->first->next = nullptr;
+    this->current = this->first;
+    this->used = 0;
+  }
+  else if(this->used == chunk_size)
+  {
+    // Reuse chunks left after release before allocating new one
+    if(this->current->next == nullptr)
+    {
+      this->current->next = new Chunk;
+      this->current->next->next = nullptr;
+    }
+
+    this->current = this->current->next;
+    this->used = 0;
+  }
+
+  void *place = this->current->storage + this->used * sizeof(TreeNode);
+  ++this->used;
+
+  return new(place) TreeNode(element);
+}
+
+void sdizo::TreeNodeArena::dealloc(TreeNode *node) noexcept
+{
+  node->left = this->free_list;
+  this->free_list = node;
+}
+
+void sdizo::TreeNodeArena::release() noexcept
 {
-  this->free(this->root);
+  this->current = this->first;
+  this->used = 0;
+  this->free_list = nullptr;
 }
 
+sdizo::Tree::Tree(TreeBalance balance) noexcept
+:root{nullptr}, balance{balance}, size{0}, max_size{0} {}
+
+sdizo::Tree::~Tree() noexcept
+{}
+
 void sdizo::Tree::insert(int32_t element) noexcept
 {
-  TreeNode *new_node = new TreeNode(element);
-  this->insert(new_node);
+  // Rotations of splay move nodes across equal ones, which would put
+  // equal value in left subtree, so splay tree keeps values unique
+  if(this->balance == sdizo::TreeBalance::splay &&
+     this->access(element) != nullptr)
+    return;
+
+  TreeNode *new_node = this->arena.alloc(element);
+  auto depth = this->insert(new_node);
+
+  ++this->size;
+  this->max_size = std::max(this->max_size, this->size);
+
+  if(this->balance == sdizo::TreeBalance::splay)
+    this->splay(new_node);
+
+  if(this->balance != sdizo::TreeBalance::scapegoat)
+    return;
+
+  // Tree with all subtrees 2/3 balanced is not deeper than log_3/2(n)
+  auto depth_limit = std::log(this->size) / std::log(1.5);
+
+  if(depth <= depth_limit)
+    return;
+
+  auto scapegoat = sdizo::Tree::find_scapegoat(new_node);
+
+  if(scapegoat != nullptr)
+    this->rebalance(scapegoat);
 }
 
-void sdizo::Tree::insert(TreeNode *node) noexcept
+int32_t sdizo::Tree::insert(TreeNode *node) noexcept
 {
   TreeNode *current_parent = nullptr;
   TreeNode *current_node = this->root;
+  int32_t depth = 0;
+
   while(current_node != nullptr)
   {
     current_parent = current_node;
+    ++depth;
 
     if(node->value < current_node->value)
       current_node = current_node->left;
@@ -43,6 +136,53 @@ void sdizo::Tree::insert(TreeNode *node) noexcept
     current_parent->left = node;
   else
     current_parent->right = node;
+
+  return depth;
+}
+
+TreeNode *sdizo::Tree::find_scapegoat(TreeNode *node) noexcept
+{
+  TreeNode *child = node;
+  int32_t child_size = sdizo::Tree::subtree_size(node);
+
+  while(child->parent != nullptr)
+  {
+    TreeNode *parent = child->parent;
+    TreeNode *sibling = parent->left == child ? parent->right : parent->left;
+    int32_t parent_size = child_size + 1 + sdizo::Tree::subtree_size(sibling);
+
+    if(3 * child_size > 2 * parent_size)
+      return parent;
+
+    child = parent;
+    child_size = parent_size;
+  }
+
+  return nullptr;
+}
+
+int32_t sdizo::Tree::subtree_size(const TreeNode *node) noexcept
+{
+  if(node == nullptr)
+    return 0;
+
+  int32_t size = 0;
+  std::vector<const TreeNode*> stack{node};
+
+  while(!stack.empty())
+  {
+    node = stack.back();
+    stack.pop_back();
+    ++size;
+
+    if(node->left != nullptr)
+      stack.push_back(node->left);
+
+    if(node->right != nullptr)
+      stack.push_back(node->right);
+  }
+
+  return size;
 }
 
 void sdizo::Tree::remove(TreeNode *node)
@@ -78,7 +218,113 @@ void sdizo::Tree::remove(TreeNode *node)
   if(to_delete != node)
     node->value = to_delete->value;
 
-  delete to_delete;
+  if(this->balance == sdizo::TreeBalance::splay &&
+     to_delete->parent != nullptr)
+    this->splay(to_delete->parent);
+
+  this->arena.dealloc(to_delete);
+  --this->size;
+
+  // Rebuild whole tree once it shrinks too much since last rebuild
+  if(this->balance == sdizo::TreeBalance::scapegoat &&
+     3 * this->size < 2 * this->max_size)
+  {
+    if(this->root != nullptr)
+      this->rebalance(this->root);
+
+    this->max_size = this->size;
+  }
+}
+
+void sdizo::Tree::bulk_build
+(const int32_t *first, const int32_t *last, bool parallel) noexcept
+{
+  assert(std::is_sorted(first, last));
+
+  this->clear();
+
+  int32_t size = last - first;
+  if(size <= 0)
+    return;
+
+  // Arena is not thread safe, so nodes are allocated up front
+  // and only linked in parallel.
+  TreeNode **nodes = new TreeNode*[size];
+  bool unique = this->balance == sdizo::TreeBalance::splay;
+  int32_t count = 0;
+  for(int32_t i = 0; i < size; ++i)
+  {
+    if(unique && count > 0 && nodes[count - 1]->value == first[i])
+      continue;
+
+    nodes[count++] = this->arena.alloc(first[i]);
+  }
+  size = count;
+
+  int32_t fork_depth = 0;
+  if(parallel)
+  {
+    unsigned threads = std::thread::hardware_concurrency();
+    while((1u << fork_depth) < threads)
+      ++fork_depth;
+  }
+
+  this->root = sdizo::Tree::link_balanced(nodes, 0, size, nullptr,
+                                          fork_depth);
+  this->size = size;
+  this->max_size = size;
+
+  delete [] nodes;
+}
+
+TreeNode *sdizo::Tree::link_balanced
+(TreeNode **nodes, int32_t begin, int32_t end, TreeNode *parent,
+ int32_t fork_depth) noexcept
+{
+  std::vector<std::thread> workers;
+  TreeNode *subroot = nullptr;
+  TreeNode **slot = &subroot;
+
+  // Right subtrees are linked in loop, so run of equal values
+  // (which must go right) does not deepen recursion.
+  while(begin < end)
+  {
+    int32_t mid = begin + (end - begin) / 2;
+
+    // Left subtree must hold only smaller values, so middle
+    // moves to start of its run of equal values
+    mid = std::lower_bound(nodes + begin, nodes + mid, nodes[mid],
+                           [](const TreeNode *a, const TreeNode *b){
+      return a->value < b->value;
+    }) - nodes;
+
+    TreeNode *node = nodes[mid];
+    node->parent = parent;
+    *slot = node;
+
+    if(fork_depth > 0 && mid - begin >= sdizo::Tree::parallel_cutoff)
+    {
+      --fork_depth;
+      workers.emplace_back([=]{
+        node->left = link_balanced(nodes, begin, mid, node, fork_depth);
+      });
+    }
+    else
+    {
+      node->left = link_balanced(nodes, begin, mid, node, fork_depth);
+    }
+
+    parent = node;
+    slot = &node->right;
+    begin = mid + 1;
+  }
+
+  *slot = nullptr;
+
+  for(auto &worker : workers)
+    worker.join();
+
+  return subroot;
 }
 
 void sdizo::Tree::generate
@@ -109,6 +355,75 @@ TreeNode *sdizo::Tree::search(int32_t element) const noexcept
   return current;
 }
 
+TreeNode *sdizo::Tree::access(int32_t element) noexcept
+{
+  if(this->balance != sdizo::TreeBalance::splay)
+    return this->search(element);
+
+  TreeNode *last = nullptr;
+  TreeNode *current = this->root;
+  while(current != nullptr && current->value != element)
+  {
+    last = current;
+
+    if(current->value < element)
+      current = current->right;
+    else
+      current = current->left;
+  }
+
+  if(current != nullptr)
+    this->splay(current);
+  else if(last != nullptr)
+    this->splay(last);
+
+  return current;
+}
+
+void sdizo::Tree::splay(TreeNode *node) noexcept
+{
+  while(node->parent != nullptr)
+  {
+    TreeNode *parent = node->parent;
+    TreeNode *grand = parent->parent;
+    bool is_left = node == parent->left;
+
+    if(grand == nullptr)
+    {
+      // zig
+      if(is_left) rot_right(parent); else rot_left(parent);
+    }
+    else if(is_left == (parent == grand->left))
+    {
+      // zig-zig
+      if(is_left)
+      {
+        rot_right(grand);
+        rot_right(parent);
+      }
+      else
+      {
+        rot_left(grand);
+        rot_left(parent);
+      }
+    }
+    else
+    {
+      // zig-zag
+      if(is_left)
+      {
+        rot_right(parent);
+        rot_left(grand);
+      }
+      else
+      {
+        rot_left(parent);
+        rot_right(grand);
+      }
+    }
+  }
+}
+
 TreeNode* sdizo::Tree::successor(TreeNode *root) noexcept
 {
   assert(root);
@@ -219,12 +534,27 @@ unsigned sdizo::Tree::log2(unsigned x) noexcept
 }
 
 void sdizo::Tree::dsw() noexcept
+{
+  if(this->root != nullptr)
+    this->rebalance(this->root);
+}
+
+void sdizo::Tree::rebalance(TreeNode *subroot) noexcept
 {
   unsigned n,i,s;
   TreeNode* p;
 
+  // Rotations replace top of subtree, it is always found
+  // under the same parent.
+  TreeNode *above = subroot->parent;
+  bool is_left = above != nullptr && above->left == subroot;
+  auto top = [&]{
+    if(above == nullptr) return this->root;
+    return is_left ? above->left : above->right;
+  };
+
   n = 0;
-  p = this->root;
+  p = subroot;
   while(p)
     if(p->left)
       {
@@ -239,7 +569,7 @@ void sdizo::Tree::dsw() noexcept
 
   s = n + 1 - sdizo::Tree::log2(n + 1);
 
-  p = root;
+  p = top();
   for(i = 0; i < s; i++)
   {
     rot_left(p);
@@ -252,7 +582,7 @@ void sdizo::Tree::dsw() noexcept
   while(n > 1)
   {
     n >>= 1;
-    p = root;
+    p = top();
     for(i = 0; i < n; i++)
     {
       rot_left(p);
@@ -260,6 +590,7 @@ void sdizo::Tree::dsw() noexcept
     }
   }
 }
+
 void sdizo::Tree::display() const noexcept
 {
   puts("===========================");
@@ -267,54 +598,75 @@ void sdizo::Tree::display() const noexcept
   puts("===========================");
 }
 
-bool sdizo::Tree::verify_values() const noexcept
+sdizo::TreeSnapshot sdizo::Tree::snapshot() const noexcept
 {
-  return sdizo::Tree::verify_(this->root);
+  return sdizo::TreeSnapshot(*this);
 }
 
-bool sdizo::Tree::verify_(TreeNode *root) noexcept
+bool sdizo::Tree::verify_values() const noexcept
 {
-  if(root == nullptr)
+  if(this->root == nullptr)
     return true;
 
-  if(!(verify_(root->left) & verify_(root->right)))
-    return false;
+  // Iterative, so degenerated trees do not overflow stack
+  std::vector<const TreeNode*> stack{this->root};
 
-  if(root->right != nullptr && root->value > root->right->value)
-    return false;
+  while(!stack.empty())
+  {
+    const TreeNode *node = stack.back();
+    stack.pop_back();
 
-  if(root->left != nullptr && root->value <= root->left->value)
-    return false;
+    if(node->right != nullptr)
+    {
+      if(node->value > node->right->value)
+        return false;
+
+      stack.push_back(node->right);
+    }
+
+    if(node->left != nullptr)
+    {
+      if(node->value <= node->left->value)
+        return false;
+
+      stack.push_back(node->left);
+    }
+  }
 
   return true;
 }
 
 bool sdizo::Tree::verify_connections() const noexcept
 {
-  return this->verify_connections(this->root) && this->root->parent == nullptr;
-}
-
-bool sdizo::Tree::verify_connections(TreeNode *node) noexcept
-{
-  if(node == nullptr)
+  if(this->root == nullptr)
     return true;
 
-  if(node->left != nullptr && node->left->parent != node)
+  if(this->root->parent != nullptr)
     return false;
 
-  if(node->right != nullptr && node->right->parent != node)
-    return false;
+  std::vector<const TreeNode*> stack{this->root};
 
-  return sdizo::Tree::verify_connections(node->left) && sdizo::Tree::verify_connections(node->right);
+  while(!stack.empty())
+  {
+    const TreeNode *node = stack.back();
+    stack.pop_back();
 
-}
+    if(node->left != nullptr)
+    {
+      if(node->left->parent != node)
+        return false;
 
-void sdizo::Tree::free(TreeNode *to_delete) noexcept
-{
-  if(to_delete == nullptr)
-    return;
+      stack.push_back(node->left);
+    }
+
+    if(node->right != nullptr)
+    {
+      if(node->right->parent != node)
+        return false;
 
-  sdizo::Tree::free(to_delete->left);
-  sdizo::Tree::free(to_delete->right);
-  delete to_delete;
+      stack.push_back(node->right);
+    }
+  }
+
+  return true;
 }
@@ -2,6 +2,8 @@
 #include <cstdint>
 
 namespace sdizo{
+  class TreeSnapshot;
+
   struct TreeNode
   {
     int32_t value;
@@ -13,31 +15,91 @@ namespace sdizo{
     :value{element}, left{nullptr}, right{nullptr}, parent{nullptr} {}
   };
 
+  // Allocates TreeNodes in chunks, so building tree does not call new
+  // for every node. All nodes are released at once in O(1), chunks are
+  // kept and reused by next allocations. Single nodes given back with
+  // dealloc are kept on free list.
+  class TreeNodeArena
+  {
+    private:
+      static constexpr int32_t chunk_size = 1024;
+
+      struct Chunk
+      {
+        Chunk *next;
+        alignas(TreeNode) unsigned char storage[chunk_size * sizeof(TreeNode)];
+      };
+
+      Chunk *first;
+      Chunk *current;
+      // Count of nodes taken from current chunk.
+      int32_t used;
+      // Deallocated nodes linked through left pointer.
+      TreeNode *free_list;
+
+    public:
+      TreeNodeArena() noexcept;
+      TreeNodeArena(const TreeNodeArena&) = delete;
+      ~TreeNodeArena() noexcept;
+
+      TreeNode *alloc(int32_t element) noexcept;
+      void dealloc(TreeNode *node) noexcept;
+
+      // Releases all nodes, previously allocated pointers become invalid.
+      void release() noexcept;
+  };
+
+  // How tree keeps itself balanced.
+  // none      - only by explicit dsw() call.
+  // scapegoat - after insert goes too deep, subtree that got out of
+  //             balance is rebuilt with DSW, removes rebuild whole tree
+  //             once it shrinks enough. Insert and search are
+  //             O(log n) amortized.
+  // splay     - accessed, inserted nodes and parents of removed ones are
+  //             moved to root with rotations, so frequently used keys
+  //             stay near the root. Inserting value already in
+  //             tree only splays it, so values are unique.
+  enum class TreeBalance
+  {none, scapegoat, splay};
+
   class Tree
   {
     public:
       TreeNode *root;
 
     public:
-      Tree() noexcept;
+      Tree(TreeBalance balance = TreeBalance::none) noexcept;
       ~Tree() noexcept;
 
       int32_t loadFromFile() noexcept;
 
       void insert(int32_t element) noexcept;
-      void insert(TreeNode *node) noexcept;
 
       // If tries to remove from empty tree, std::length_error is thrown.
       void remove(TreeNode *to_delete);
 
+      // Replaces content with perfectly balanced tree built from sorted
+      // range [first, last) in linear time. If parallel is set, subtrees
+      // of large ranges are linked on separate threads.
+      void bulk_build(const int32_t *first, const int32_t *last,
+                      bool parallel = false) noexcept;
+
       // Randomly generates table.
       void generate(int32_t rand_range_begin, int32_t rand_range_end,
                     int32_t size) noexcept;
       inline void clear() noexcept
-      {this->free(this->root); this->root = nullptr;}
+      {this->arena.release(); this->root = nullptr;
+       this->size = 0; this->max_size = 0;}
+
+      inline int32_t get_size() const noexcept
+      {return this->size;}
 
       TreeNode *search(int32_t element) const noexcept;
 
+      // Same as search, but in splay mode moves found node (or last node
+      // visited if element is missing) to the root.
+      TreeNode *access(int32_t element) noexcept;
+
       // Returns nullptr if there is no successor.
       // Otherwise valid poiter is returned.
       static TreeNode* successor(TreeNode *node) noexcept;
@@ -56,10 +118,39 @@ namespace sdizo{
       bool verify_values() const noexcept;
       bool verify_connections() const noexcept;
 
+      // Returns immutable, cache friendly copy of tree for read only use.
+      TreeSnapshot snapshot() const noexcept;
+
     private:
-      // Recursively free's node and its childs.
-      static void free(TreeNode *to_delete) noexcept;
-      static bool verify_(TreeNode *root) noexcept;
-      static bool verify_connections(TreeNode *node) noexcept;
+      TreeNodeArena arena;
+      TreeBalance balance;
+      int32_t size;
+      // Largest size since last full rebuild, used by scapegoat mode.
+      int32_t max_size;
+
+      // Ranges shorter than that are not worth new thread in bulk_build.
+      static constexpr int32_t parallel_cutoff = 1 << 14;
+
+      // Links node allocated from arena into tree.
+      // Returns depth at which node was linked.
+      int32_t insert(TreeNode *node) noexcept;
+
+      // Moves node to the root with zig, zig-zig and zig-zag rotations.
+      void splay(TreeNode *node) noexcept;
+
+      // Rebuilds subtree rooted at given node into balanced one
+      // using DSW rotations.
+      void rebalance(TreeNode *subroot) noexcept;
+
+      // Finds ancestor of node with one child subtree heavier than
+      // 2/3 of its own size, nullptr if there is no such.
+      static TreeNode *find_scapegoat(TreeNode *node) noexcept;
+      static int32_t subtree_size(const TreeNode *node) noexcept;
+
+      // Links sorted nodes[begin, end) into balanced subtree,
+      // returns its root. Forks up to fork_depth levels onto threads.
+      static TreeNode *link_balanced(TreeNode **nodes, int32_t begin,
+                                     int32_t end, TreeNode *parent,
+                                     int32_t fork_depth) noexcept;
     };
 }
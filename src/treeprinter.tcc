@@ -1,15 +1,19 @@
 #include <stdio.h>
 #include <type_traits>
 #include "tree.hpp"
-#include "redblacktree.hpp"
 #include "heap.hpp"
 #include "common.hpp"
 
 static constexpr int shift_width = 10;
 
 using sdizo::TreeNode;
-using sdizo::RedBlackNode;
-using sdizo::NodeColor;
+
+// Red black tree nodes are the ones having color.
+template<typename T, typename = void>
+struct is_colored_node : std::false_type {};
+
+template<typename T>
+struct is_colored_node<T, std::void_t<decltype(T::color)>> : std::true_type {};
 
 template<typename T>
 void printTree(const T *root, int space) noexcept
@@ -21,20 +25,23 @@ void printTree(const T *root, int space) noexcept
 
     printTree(root->right, space);
 
-    if constexpr(std::is_same<T, sdizo::RedBlackNode>::value)
+    constexpr bool colored = is_colored_node<T>::value;
+
+    if constexpr(colored)
     {
-      if(root->color == NodeColor::red)
+      if(root->color == decltype(root->color)::red)
       {
         printf("\u001b[31m");
       }
     }
 
-    if(root->value == sdizo::RedBlackTree::GUARD_VALUE) 
+    // Red black tree guard node is the only one without childs
+    if(colored && root->left == nullptr && root->right == nullptr)
       printf("\n%*s%c\n", space - shift_width, " ", 'N');
     else
       printf("\n%*s%i\n", space - shift_width, " ", root->value);
 
-    if constexpr(std::is_same<T, sdizo::RedBlackNode>::value)
+    if constexpr(colored)
       printf("\u001b[0m");
 
     printTree(root->left, space);
@@ -73,5 +80,3 @@ void print2D(const sdizo::Heap<ElemType, heap_t> *heap) noexcept
 
 template void print2D<const TreeNode>(const TreeNode *root) noexcept;
 template void printTree<const TreeNode>(const TreeNode *root, int space) noexcept;
-template void print2D<const RedBlackNode>(const RedBlackNode *root) noexcept;
-template void printTree<const RedBlackNode>(const RedBlackNode *root, int space) noexcept;
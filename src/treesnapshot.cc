@@ -0,0 +1,187 @@
+#include "treesnapshot.hpp"
+#include "tree.hpp"
+
+sdizo::TreeSnapshot::TreeSnapshot(const Tree &tree) noexcept
+:data{nullptr}, size{0}, height{0},
+ bottom_size{}, top_size{}, top_depth{}
+{
+  if(tree.root == nullptr)
+    return;
+
+  // Tree values in order
+  this->size = tree.get_size();
+  int32_t *sorted = new int32_t[this->size];
+  int32_t count = 0;
+
+  for(auto node = sdizo::Tree::min(tree.root); node != nullptr;
+      node = sdizo::Tree::successor(node))
+    sorted[count++] = node->value;
+
+  // Smallest perfect tree able to hold all values,
+  // spare places are filled with largest value.
+  while((int64_t(1) << this->height) - 1 < this->size)
+    ++this->height;
+
+  this->data = new int32_t[(int64_t(1) << this->height) - 1];
+  this->split(0, this->height);
+
+  int32_t next = 0;
+  int32_t pos[max_height];
+  this->fill(sorted, next, 1, 0, pos);
+
+  delete [] sorted;
+}
+
+sdizo::TreeSnapshot::TreeSnapshot(TreeSnapshot&& snapshot) noexcept
+:data{snapshot.data}, size{snapshot.size}, height{snapshot.height}
+{
+  for(int32_t i = 0; i < max_height; ++i)
+  {
+    this->bottom_size[i] = snapshot.bottom_size[i];
+    this->top_size[i] = snapshot.top_size[i];
+    this->top_depth[i] = snapshot.top_depth[i];
+  }
+
+  snapshot.data = nullptr;
+  snapshot.size = 0;
+  snapshot.height = 0;
+}
+
+sdizo::TreeSnapshot::~TreeSnapshot() noexcept
+{
+  delete [] this->data;
+}
+
+void sdizo::TreeSnapshot::split(int32_t depth, int32_t subtree_height)
+noexcept
+{
+  if(subtree_height <= 1)
+    return;
+
+  int32_t top_height = subtree_height / 2;
+  int32_t bottom_height = subtree_height - top_height;
+  int32_t bottom_depth = depth + top_height;
+
+  this->top_depth[bottom_depth] = depth;
+  this->top_size[bottom_depth] = (1 << top_height) - 1;
+  this->bottom_size[bottom_depth] = (1 << bottom_height) - 1;
+
+  this->split(depth, top_height);
+  this->split(bottom_depth, bottom_height);
+}
+
+void sdizo::TreeSnapshot::fill
+(const int32_t *sorted, int32_t &next, uint32_t index, int32_t depth,
+ int32_t *pos) noexcept
+{
+  if(depth == this->height)
+    return;
+
+  pos[depth] = this->position(index, depth, pos);
+
+  this->fill(sorted, next, index << 1, depth + 1, pos);
+
+  this->data[pos[depth]] = next < this->size ? sorted[next]
+                                             : sorted[this->size - 1];
+  ++next;
+
+  this->fill(sorted, next, (index << 1) | 1, depth + 1, pos);
+}
+
+const int32_t *sdizo::TreeSnapshot::search(int32_t element) const noexcept
+{
+  int32_t pos[max_height];
+  uint32_t index = 1;
+
+  for(int32_t depth = 0; depth < this->height; ++depth)
+  {
+    pos[depth] = this->position(index, depth, pos);
+    const int32_t *current = &this->data[pos[depth]];
+
+    if(*current == element)
+      return current;
+
+    index = (index << 1) | (*current < element);
+  }
+
+  return nullptr;
+}
+
+const int32_t *sdizo::TreeSnapshot::successor(int32_t element)
+const noexcept
+{
+  int32_t pos[max_height];
+  uint32_t index = 1;
+  const int32_t *candidate = nullptr;
+
+  for(int32_t depth = 0; depth < this->height; ++depth)
+  {
+    pos[depth] = this->position(index, depth, pos);
+    const int32_t *current = &this->data[pos[depth]];
+
+    bool go_left = *current > element;
+    if(go_left)
+      candidate = current;
+
+    index = (index << 1) | !go_left;
+  }
+
+  return candidate;
+}
+
+const int32_t *sdizo::TreeSnapshot::predecessor(int32_t element)
+const noexcept
+{
+  int32_t pos[max_height];
+  uint32_t index = 1;
+  const int32_t *candidate = nullptr;
+
+  for(int32_t depth = 0; depth < this->height; ++depth)
+  {
+    pos[depth] = this->position(index, depth, pos);
+    const int32_t *current = &this->data[pos[depth]];
+
+    bool go_right = *current < element;
+    if(go_right)
+      candidate = current;
+
+    index = (index << 1) | go_right;
+  }
+
+  return candidate;
+}
+
+const int32_t *sdizo::TreeSnapshot::min() const noexcept
+{
+  if(this->size == 0)
+    return nullptr;
+
+  int32_t pos[max_height];
+  uint32_t index = 1;
+
+  for(int32_t depth = 0; depth < this->height; ++depth)
+  {
+    pos[depth] = this->position(index, depth, pos);
+    index <<= 1;
+  }
+
+  return &this->data[pos[this->height - 1]];
+}
+
+const int32_t *sdizo::TreeSnapshot::max() const noexcept
+{
+  if(this->size == 0)
+    return nullptr;
+
+  // Spare places hold largest value, rightmost one is always the largest
+  int32_t pos[max_height];
+  uint32_t index = 1;
+
+  for(int32_t depth = 0; depth < this->height; ++depth)
+  {
+    pos[depth] = this->position(index, depth, pos);
+    index = (index << 1) | 1;
+  }
+
+  return &this->data[pos[this->height - 1]];
+}
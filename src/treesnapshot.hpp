@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+
+namespace sdizo{
+  class Tree;
+
+  // Immutable copy of Tree values kept in van Emde Boas layout.
+  // Values form perfect binary search tree stored in single array,
+  // where tree is split in half of its height into top subtree and
+  // bottom subtrees, each stored contiguously and laid out the same way
+  // recursively. Children are not stored, their positions are computed
+  // while descending, so search touches O(log_B n) cache lines.
+  class TreeSnapshot
+  {
+    private:
+      static constexpr int32_t max_height = 32;
+
+      int32_t *data;
+      // Count of values taken from tree.
+      int32_t size;
+      // Count of levels of perfect tree.
+      int32_t height;
+
+      // For every depth at which some bottom subtree starts: size of that
+      // bottom subtree, size of top subtree above it and depth of top
+      // subtree root.
+      int32_t bottom_size[max_height];
+      int32_t top_size[max_height];
+      int32_t top_depth[max_height];
+
+    public:
+      TreeSnapshot(const Tree &tree) noexcept;
+      TreeSnapshot(const TreeSnapshot&) = delete;
+      TreeSnapshot(TreeSnapshot&& snapshot) noexcept;
+      ~TreeSnapshot() noexcept;
+
+      // Returns nullptr if no valid value were found.
+      // Otherwise pointer to value inside snapshot is returned.
+      const int32_t *search(int32_t element) const noexcept;
+      // Smallest value greater than element.
+      const int32_t *successor(int32_t element) const noexcept;
+      // Largest value less than element.
+      const int32_t *predecessor(int32_t element) const noexcept;
+      const int32_t *min() const noexcept;
+      const int32_t *max() const noexcept;
+
+      inline bool contains(int32_t element) const noexcept
+      {return this->search(element) != nullptr;}
+
+      inline int32_t get_size() const noexcept
+      {return this->size;}
+
+    private:
+      // Fills layout tables for subtree of given height rooted at depth.
+      void split(int32_t depth, int32_t subtree_height) noexcept;
+
+      // Places sorted values into layout in order of perfect tree.
+      void fill(const int32_t *sorted, int32_t &next, uint32_t index,
+                int32_t depth, int32_t *pos) noexcept;
+
+      // Position in data of node at depth with given breadth first index
+      // (root is 1), pos holds positions of its ancestors.
+      inline int32_t position(uint32_t index, int32_t depth,
+                              const int32_t *pos) const noexcept
+      {
+        if(depth == 0)
+          return 0;
+
+        uint32_t bottom_index = index & uint32_t(this->top_size[depth]);
+        return pos[this->top_depth[depth]] + this->top_size[depth] +
+               int32_t(bottom_index) * this->bottom_size[depth];
+      }
+  };
+}
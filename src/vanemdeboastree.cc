@@ -0,0 +1,434 @@
+#include "vanemdeboastree.hpp"
+#include <algorithm>
+#include <random>
+#include <fstream>
+#include <cstdio>
+#include <type_traits>
+#include <unordered_map>
+
+namespace sdizo{
+  // Set of keys in [0, 2^Bits) small enough for single word.
+  template<int32_t Bits>
+  class VebLeaf
+  {
+    static_assert(Bits <= 6);
+
+    private:
+      uint64_t bits = 0;
+
+    public:
+      inline bool empty() const noexcept
+      {return this->bits == 0;}
+
+      inline uint32_t min() const noexcept
+      {return __builtin_ctzll(this->bits);}
+
+      inline uint32_t max() const noexcept
+      {return 63 - __builtin_clzll(this->bits);}
+
+      inline bool contains(uint32_t key) const noexcept
+      {return this->bits >> key & 1;}
+
+      // Returns false if key was already in set.
+      inline bool insert(uint32_t key) noexcept
+      {
+        auto before = this->bits;
+        this->bits |= uint64_t{1} << key;
+        return this->bits != before;
+      }
+
+      // Returns false if key was not in set.
+      inline bool remove(uint32_t key) noexcept
+      {
+        auto before = this->bits;
+        this->bits &= ~(uint64_t{1} << key);
+        return this->bits != before;
+      }
+
+      inline bool successor(uint32_t key, uint32_t &next) const noexcept
+      {
+        auto greater = key >= 63 ? 0 : this->bits >> (key + 1) << (key + 1);
+        if(greater == 0)
+          return false;
+
+        next = __builtin_ctzll(greater);
+        return true;
+      }
+
+      inline bool predecessor(uint32_t key, uint32_t &previous) const noexcept
+      {
+        auto lower = this->bits & ((uint64_t{1} << key) - 1);
+        if(lower == 0)
+          return false;
+
+        previous = 63 - __builtin_clzll(lower);
+        return true;
+      }
+
+      template<typename Visitor>
+      void visit(uint32_t offset, Visitor &&visitor) const
+      {
+        for(auto bits = this->bits; bits != 0; bits &= bits - 1)
+          visitor(offset + __builtin_ctzll(bits));
+      }
+
+      inline bool verify() const noexcept
+      {return true;}
+  };
+
+  // Keys of 2^Bits universe are split into high half, index of cluster,
+  // and low half, key in cluster. Minimum is kept only in node itself,
+  // which makes inserting into empty cluster O(1), so every operation
+  // recurses into at most one non trivial call.
+  template<int32_t Bits>
+  class VebNode
+  {
+    private:
+      static constexpr int32_t low_bits = Bits / 2;
+      static constexpr int32_t high_bits = Bits - low_bits;
+
+      template<int32_t B>
+      using node_t = std::conditional_t<(B <= 6), VebLeaf<B>, VebNode<B>>;
+      using cluster_t = node_t<low_bits>;
+      using summary_t = node_t<high_bits>;
+
+      // Empty node has low greater than high.
+      uint32_t low = 1;
+      uint32_t high = 0;
+      // Indices of non empty clusters.
+      summary_t summary;
+      std::unordered_map<uint32_t, cluster_t> clusters;
+
+      static inline uint32_t cluster_index(uint32_t key) noexcept
+      {return key >> low_bits;}
+
+      static inline uint32_t cluster_key(uint32_t key) noexcept
+      {return key & ((uint32_t{1} << low_bits) - 1);}
+
+      static inline uint32_t join(uint32_t index, uint32_t key) noexcept
+      {return index << low_bits | key;}
+
+    public:
+      inline bool empty() const noexcept
+      {return this->low > this->high;}
+
+      inline uint32_t min() const noexcept
+      {return this->low;}
+
+      inline uint32_t max() const noexcept
+      {return this->high;}
+
+      bool contains(uint32_t key) const noexcept
+      {
+        if(key == this->low || key == this->high)
+          return !this->empty();
+
+        auto cluster = this->clusters.find(cluster_index(key));
+        return cluster != this->clusters.end() &&
+               cluster->second.contains(cluster_key(key));
+      }
+
+      bool insert(uint32_t key)
+      {
+        if(this->empty())
+        {
+          this->low = this->high = key;
+          return true;
+        }
+
+        if(key == this->low || key == this->high)
+          return false;
+
+        // New minimum stays in node, old one goes down
+        if(key < this->low)
+          std::swap(key, this->low);
+
+        auto index = cluster_index(key);
+        auto cluster = this->clusters.find(index);
+        if(cluster == this->clusters.end())
+        {
+          this->clusters[index].insert(cluster_key(key));
+          this->summary.insert(index);
+        }
+        else if(!cluster->second.insert(cluster_key(key)))
+          return false;
+
+        this->high = std::max(this->high, key);
+        return true;
+      }
+
+      bool remove(uint32_t key) noexcept
+      {
+        if(this->empty())
+          return false;
+
+        if(this->low == this->high)
+        {
+          if(key != this->low)
+            return false;
+
+          this->low = 1;
+          this->high = 0;
+          return true;
+        }
+
+        // Smallest element of clusters becomes new minimum
+        if(key == this->low)
+        {
+          auto index = this->summary.min();
+          key = join(index, this->clusters.find(index)->second.min());
+          this->low = key;
+        }
+
+        auto index = cluster_index(key);
+        auto cluster = this->clusters.find(index);
+        if(cluster == this->clusters.end() ||
+           !cluster->second.remove(cluster_key(key)))
+          return false;
+
+        if(cluster->second.empty())
+        {
+          this->clusters.erase(cluster);
+          this->summary.remove(index);
+        }
+
+        if(key == this->high)
+        {
+          if(this->summary.empty())
+            this->high = this->low;
+          else
+          {
+            index = this->summary.max();
+            this->high = join(index, this->clusters.find(index)->second.max());
+          }
+        }
+
+        return true;
+      }
+
+      bool successor(uint32_t key, uint32_t &next) const noexcept
+      {
+        if(this->empty() || key >= this->high)
+          return false;
+
+        if(key < this->low)
+        {
+          next = this->low;
+          return true;
+        }
+
+        // Maximum is in clusters, so next element is too. Cluster
+        // without greater key answers in O(1)
+        auto index = cluster_index(key);
+        auto cluster = this->clusters.find(index);
+        uint32_t found;
+        if(cluster != this->clusters.end() &&
+           cluster->second.successor(cluster_key(key), found))
+        {
+          next = join(index, found);
+          return true;
+        }
+
+        if(!this->summary.successor(index, index))
+          return false;
+
+        next = join(index, this->clusters.find(index)->second.min());
+        return true;
+      }
+
+      bool predecessor(uint32_t key, uint32_t &previous) const noexcept
+      {
+        if(this->empty() || key <= this->low)
+          return false;
+
+        if(key > this->high)
+        {
+          previous = this->high;
+          return true;
+        }
+
+        auto index = cluster_index(key);
+        auto cluster = this->clusters.find(index);
+        uint32_t found;
+        if(cluster != this->clusters.end() &&
+           cluster->second.predecessor(cluster_key(key), found))
+        {
+          previous = join(index, found);
+          return true;
+        }
+
+        // Nothing lower in clusters, minimum is
+        if(!this->summary.predecessor(index, index))
+        {
+          previous = this->low;
+          return true;
+        }
+
+        previous = join(index, this->clusters.find(index)->second.max());
+        return true;
+      }
+
+      // Calls visitor(key) for all keys in ascending order.
+      template<typename Visitor>
+      void visit(uint32_t offset, Visitor &&visitor) const
+      {
+        if(this->empty())
+          return;
+
+        visitor(offset + this->low);
+        this->summary.visit(0, [&](uint32_t index){
+          this->clusters.find(index)->second.visit(offset + join(index, 0),
+                                                   visitor);
+        });
+      }
+
+      bool verify() const noexcept
+      {
+        if(this->empty())
+          return this->clusters.empty() && this->summary.empty();
+
+        int32_t summary_size = 0;
+        bool summary_valid = true;
+        this->summary.visit(0, [&](uint32_t index){
+          ++summary_size;
+          summary_valid &= this->clusters.count(index) == 1;
+        });
+
+        if(!summary_valid || !this->summary.verify() ||
+           summary_size != int32_t(this->clusters.size()))
+          return false;
+
+        if(this->clusters.empty())
+          return this->low == this->high;
+
+        for(auto &[index, cluster] : this->clusters)
+        {
+          if(cluster.empty() || !cluster.verify() ||
+             join(index, cluster.min()) <= this->low ||
+             join(index, cluster.max()) > this->high)
+            return false;
+        }
+
+        // Maximum is stored in clusters unless it is minimum
+        auto last = this->summary.max();
+        return join(last, this->clusters.find(last)->second.max()) ==
+               this->high;
+      }
+  };
+}
+
+// Flipping sign bit maps int32_t order onto uint32_t order.
+static inline uint32_t to_key(int32_t element) noexcept
+{
+  return uint32_t(element) ^ 0x80000000u;
+}
+
+static inline int32_t to_element(uint32_t key) noexcept
+{
+  return int32_t(key ^ 0x80000000u);
+}
+
+sdizo::VanEmdeBoasTree::VanEmdeBoasTree()
+:root{new VebNode<32>}, size{0}
+{}
+
+sdizo::VanEmdeBoasTree::~VanEmdeBoasTree() noexcept
+{
+  delete this->root;
+}
+
+int32_t sdizo::VanEmdeBoasTree::loadFromFile(const char *filename)
+{
+  std::ifstream file(filename);
+  int32_t num;
+  int32_t count;
+
+  file >> count;
+
+  while(file >> num && count)
+  {
+    this->insert(num);
+    --count;
+  }
+
+  return 0;
+}
+
+void sdizo::VanEmdeBoasTree::insert(int32_t element)
+{
+  this->size += this->root->insert(to_key(element));
+}
+
+void sdizo::VanEmdeBoasTree::remove(int32_t element) noexcept
+{
+  this->size -= this->root->remove(to_key(element));
+}
+
+void sdizo::VanEmdeBoasTree::generate
+(int32_t rand_range_begin, int32_t rand_range_end, int32_t size)
+{
+  std::random_device generator;
+  std::uniform_int_distribution<int32_t>
+   distribution(rand_range_begin, rand_range_end);
+
+  this->clear();
+  for(int32_t i = 0; i < size; ++i)
+  {
+    this->insert(distribution(generator));
+  }
+}
+
+void sdizo::VanEmdeBoasTree::clear()
+{
+  delete this->root;
+  this->root = new VebNode<32>;
+  this->size = 0;
+}
+
+bool sdizo::VanEmdeBoasTree::contains(int32_t element) const noexcept
+{
+  return this->root->contains(to_key(element));
+}
+
+bool sdizo::VanEmdeBoasTree::successor
+(int32_t element, int32_t &next) const noexcept
+{
+  uint32_t key;
+  if(!this->root->successor(to_key(element), key))
+    return false;
+
+  next = to_element(key);
+  return true;
+}
+
+bool sdizo::VanEmdeBoasTree::predecessor
+(int32_t element, int32_t &previous) const noexcept
+{
+  uint32_t key;
+  if(!this->root->predecessor(to_key(element), key))
+    return false;
+
+  previous = to_element(key);
+  return true;
+}
+
+void sdizo::VanEmdeBoasTree::display() const
+{
+  puts("===========================");
+  printf("[");
+  bool first = true;
+  this->root->visit(0, [&](uint32_t key){
+    printf(first ? "%i" : " %i", to_element(key));
+    first = false;
+  });
+  puts("]");
+  puts("===========================");
+}
+
+bool sdizo::VanEmdeBoasTree::verify() const noexcept
+{
+  int32_t count = 0;
+  this->root->visit(0, [&](uint32_t){++count;});
+
+  return count == this->size && this->root->verify();
+}
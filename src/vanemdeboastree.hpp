@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+
+namespace sdizo{
+  template<int32_t Bits>
+  class VebNode;
+
+  // Ordered set of int32_t in van Emde Boas tree over whole 32-bit
+  // universe. Every level splits key bits in halves, so operations
+  // recurse O(log log U) times, down to 64-bit bitmaps. Clusters are
+  // kept in hash maps and created on demand, so memory depends on
+  // count of elements, not universe size. Inserting element already
+  // in set does nothing.
+  class VanEmdeBoasTree
+  {
+    private:
+      VebNode<32> *root;
+      int32_t size;
+
+    public:
+      VanEmdeBoasTree();
+      VanEmdeBoasTree(const VanEmdeBoasTree&) = delete;
+      ~VanEmdeBoasTree() noexcept;
+
+      int32_t loadFromFile(const char *filename);
+      void insert(int32_t element);
+      void remove(int32_t element) noexcept;
+      void generate(int32_t rand_range_begin, int32_t rand_range_end,
+                    int32_t size);
+
+      // Removes all elements
+      void clear();
+      bool contains(int32_t element) const noexcept;
+
+      // Sets next to smallest element greater than element,
+      // returns false if there is no such element.
+      bool successor(int32_t element, int32_t &next) const noexcept;
+      // Sets previous to greatest element lower than element,
+      // returns false if there is no such element.
+      bool predecessor(int32_t element, int32_t &previous) const noexcept;
+
+      void display() const;
+
+      // Checks that minimum and maximum of every node bound its clusters
+      // and that summaries hold exactly indices of non empty clusters.
+      bool verify() const noexcept;
+
+      inline int32_t get_size() const noexcept
+      {return this->size;}
+  };
+}